@@ -1,273 +0,0 @@
-// Generated by   : ImageConverter 565 Online
-// Generated from : a02d_smoke_64.png
-// Time generated : Tue, 23 Nov 21 05:04:39 +0100  (Server timezone: CET)
-// Image Size     : 64x64 pixels
-// Memory usage   : 8192 bytes
-
-
-#if defined(__AVR__)
-    #include <avr/pgmspace.h>
-#elif defined(__PIC32MX__)
-    #define PROGMEM
-#elif defined(__arm__)
-    #define PROGMEM
-#endif
-
-const unsigned short a02d_smoke_64[4096] PROGMEM={
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0010 (16) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0020 (32) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0030 (48) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0040 (64) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0050 (80) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0060 (96) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0070 (112) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0080 (128) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0090 (144) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x00A0 (160) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x00B0 (176) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x00C0 (192) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x00D0 (208) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x00E0 (224) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x00F0 (240) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0100 (256) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0110 (272) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0120 (288) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0130 (304) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0140 (320) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0150 (336) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0160 (352) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0170 (368) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0180 (384) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0190 (400) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x01A0 (416) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x01B0 (432) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x01C0 (448) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x01D0 (464) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x01E0 (480) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x01F0 (496) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0200 (512) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0210 (528) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0220 (544) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0230 (560) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0240 (576) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0250 (592) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0260 (608) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFF9A, 0xFEEE, 0xFEEF, 0xF754, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0270 (624) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0280 (640) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0290 (656) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x02A0 (672) pixels
-0x0000, 0xFF76, 0xFF12, 0xFF55, 0xFFBA, 0x0000, 0xFFBA, 0xFEAA, 0xFEAB, 0xF6EE, 0x0000, 0xFF99, 0xFF54, 0xFF33, 0xFF99, 0x0000,   // 0x02B0 (688) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x02C0 (704) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x02D0 (720) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x02E0 (736) pixels
-0x0000, 0xFF34, 0xFE8A, 0xF6AA, 0xFF33, 0x0000, 0xFF9A, 0xFE8A, 0xFEAB, 0xFF77, 0x0000, 0xFF12, 0xFEAA, 0xFEAB, 0xFF56, 0x0000,   // 0x02F0 (752) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0300 (768) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0310 (784) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0320 (800) pixels
-0x0000, 0xFF76, 0xFECC, 0xF688, 0xFEEF, 0xFFBA, 0xFF99, 0xF689, 0xF6AA, 0xFF55, 0xF79A, 0xFEEF, 0xFE88, 0xF6CD, 0xFF98, 0x0000,   // 0x0330 (816) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0340 (832) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0350 (848) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xEF9E, 0xEF9E, 0xEF9E, 0xEFBF, 0x0000, 0x0000,   // 0x0360 (864) pixels
-0x0000, 0x0000, 0xFF32, 0xFE89, 0xFE8A, 0xFECD, 0xFEAC, 0xFE89, 0xFE89, 0xFECC, 0xFECD, 0xFE89, 0xFE8A, 0xFF33, 0x0000, 0x0000,   // 0x0370 (880) pixels
-0xFF79, 0xFFBA, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0380 (896) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0390 (912) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xE77E, 0xD71C, 0xDF3D, 0xCEBB, 0xCEBB, 0xCEDB, 0xCEBB, 0xCEBB, 0xD71C, 0xCEDB,   // 0x03A0 (928) pixels
-0x0000, 0x0000, 0xFFBC, 0xFEEE, 0xF688, 0xFE88, 0xFE89, 0xFE68, 0xFE68, 0xFE89, 0xFE89, 0xFE69, 0xFEEE, 0xFFBA, 0xFF98, 0xFF55,   // 0x03B0 (944) pixels
-0xFEEF, 0xF733, 0xFF98, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x03C0 (960) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x03D0 (976) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCEDB, 0xC6BB, 0xBE7A, 0xBE5A, 0xB67A, 0xB67A, 0xBE7A, 0xB67A, 0xBE7A, 0xC69A,   // 0x03E0 (992) pixels
-0xCEDB, 0xDF3D, 0xFFDC, 0xFF12, 0xFE89, 0xFE88, 0xFE88, 0xFE68, 0xFE68, 0xFE88, 0xFE89, 0xFE88, 0xFE89, 0xF710, 0xFEEE, 0xFE69,   // 0x03F0 (1008) pixels
-0xFE88, 0xFECE, 0xFF56, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0400 (1024) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0410 (1040) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0xD71C, 0xD6FB, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE5A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x0420 (1056) pixels
-0xBE7A, 0xC69A, 0xEF7C, 0xFFBB, 0xFF10, 0xFE88, 0xFE88, 0xFE88, 0xFE88, 0xFE88, 0xFE68, 0xFE68, 0xFE88, 0xFE68, 0xFE69, 0xFE88,   // 0x0430 (1072) pixels
-0xFEEF, 0xFF75, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0440 (1088) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0450 (1104) pixels
-0x0000, 0x0000, 0x0000, 0xDF7D, 0xCEDB, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x0460 (1120) pixels
-0xBE5A, 0xBE7A, 0xC69B, 0xC69B, 0xFF55, 0xFECC, 0xF688, 0xFE88, 0xFE89, 0xF688, 0xF688, 0xFE89, 0xFE88, 0xFE89, 0xFEAA, 0xF755,   // 0x0470 (1136) pixels
-0xFF76, 0xFFFD, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0480 (1152) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0490 (1168) pixels
-0x0000, 0x0000, 0x0000, 0xD6FC, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x04A0 (1184) pixels
-0xBE7A, 0xB67A, 0xBE7A, 0xC6BB, 0xE77D, 0xFF33, 0xF689, 0xFE68, 0xF688, 0xFE89, 0xFE88, 0xFE88, 0xFE88, 0xFE88, 0xFE8A, 0xFF9A,   // 0x04B0 (1200) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x04C0 (1216) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x04D0 (1232) pixels
-0x0000, 0x0000, 0xDF3D, 0xC69A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x04E0 (1248) pixels
-0xBE7A, 0xBE7A, 0xBE5A, 0xBE7A, 0xD6FC, 0xFF77, 0xFEEF, 0xFE69, 0xF688, 0xFE89, 0xFE88, 0xFE88, 0xFE88, 0xFE88, 0xFE69, 0xFECC,   // 0x04F0 (1264) pixels
-0xFEAC, 0xF6CD, 0xFEEE, 0xFF33, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0500 (1280) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0510 (1296) pixels
-0x0000, 0x0000, 0xD6FC, 0xB67A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x0520 (1312) pixels
-0xBE7A, 0xBE7A, 0xBE5A, 0xBE5A, 0xC6BB, 0xFFFD, 0xFF32, 0xF668, 0xFE88, 0xFE88, 0xFE88, 0xFE88, 0xFE88, 0xFE88, 0xF689, 0xF688,   // 0x0530 (1328) pixels
-0xFE88, 0xF688, 0xFE89, 0xFEAB, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0540 (1344) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0550 (1360) pixels
-0x0000, 0x0000, 0xC69A, 0xB67A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x0560 (1376) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE5A, 0xBE9A, 0xE75D, 0xFF99, 0xFE8A, 0xFE68, 0xF688, 0xFE88, 0xFE88, 0xFE88, 0xFE88, 0xFE89, 0xFF33,   // 0x0570 (1392) pixels
-0xFF55, 0xFF35, 0xFF55, 0xFF34, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0580 (1408) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0590 (1424) pixels
-0x0000, 0xE77E, 0xC67A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x05A0 (1440) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xD6FC, 0xFEF0, 0xFEAB, 0xFE88, 0xF688, 0xF688, 0xFE89, 0xFE88, 0xFE88, 0xFEAB, 0xFFBC,   // 0x05B0 (1456) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x05C0 (1472) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xE77E,   // 0x05D0 (1488) pixels
-0xD71C, 0xCEDC, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x05E0 (1504) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xCEDB, 0xFF78, 0xFF55, 0xFEEE, 0xFE8B, 0xFE68, 0xFE69, 0xF688, 0xF689, 0xFE8A, 0xFEEF,   // 0x05F0 (1520) pixels
-0xFFBA, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0600 (1536) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xDF5D, 0xCEBB, 0xBE9A,   // 0x0610 (1552) pixels
-0xBE5A, 0xBE5A, 0xB67A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x0620 (1568) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xCEDB, 0x0000, 0x0000, 0x0000, 0xFFBA, 0xFF33, 0xFEAC, 0xFE68, 0xF689, 0xF668, 0xFE68,   // 0x0630 (1584) pixels
-0xFEAB, 0xFF55, 0xFF99, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0640 (1600) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCEDB, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x0650 (1616) pixels
-0xBE5A, 0xBE5A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x0660 (1632) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xB67A, 0xCEBB, 0xCEFC, 0xCEFC, 0xC69A, 0xDF3D, 0xFFDC, 0xFF55, 0xFF33, 0xFF56, 0xF733, 0xFEAB,   // 0x0670 (1648) pixels
-0xFE88, 0xF6ED, 0xFF55, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0680 (1664) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xD6FC, 0xBE7A, 0xBE5A, 0xBE7A, 0xBE7A,   // 0x0690 (1680) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x06A0 (1696) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE5A, 0xBE7A, 0xCEBB, 0xDF3C, 0xFFBC, 0xFFBC, 0xFF78, 0xFF79,   // 0x06B0 (1712) pixels
-0xF731, 0xFF56, 0xFF97, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x06C0 (1728) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xDF1C, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x06D0 (1744) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x06E0 (1760) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE5A, 0xBE7A, 0xCEBB, 0xE73D, 0x0000, 0x0000, 0x0000,   // 0x06F0 (1776) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0700 (1792) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xEF9E, 0xC6BB, 0xB67A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x0710 (1808) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x0720 (1824) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xB67A, 0xBE7A, 0xC6BB, 0xD6FC, 0x0000, 0x0000,   // 0x0730 (1840) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0740 (1856) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xDF1C, 0xBE7A, 0xB67A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x0750 (1872) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x0760 (1888) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE5A, 0xBE7A, 0xBE7A, 0xB67A, 0xBE7A, 0xCEDB, 0x0000, 0x0000,   // 0x0770 (1904) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0780 (1920) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xD6FC, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x0790 (1936) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x07A0 (1952) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE5A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xB67A, 0xC69A, 0xDF5D, 0x0000,   // 0x07B0 (1968) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x07C0 (1984) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCEDB, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE5A, 0xBE7A,   // 0x07D0 (2000) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE5A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A,   // 0x07E0 (2016) pixels
-0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE5A, 0xBE7A, 0xBE7A, 0xBE5A, 0xBE7A, 0xBE7A, 0xBE7A, 0xCEDB, 0x0000,   // 0x07F0 (2032) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0800 (2048) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCEDB, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE5A,   // 0x0810 (2064) pixels
-0xBE7A, 0xBE7A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A,   // 0x0820 (2080) pixels
-0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xBE5A, 0xB67A, 0xBE7A, 0xBE5A, 0xBE7A, 0xBE7A, 0xBE5A, 0xBE7A, 0xBE7A, 0xC6BB, 0x0000,   // 0x0830 (2096) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0840 (2112) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCEDB, 0xBE7A, 0xBE7A, 0xBE5A, 0xBE7A, 0xB67A, 0xBE5A,   // 0x0850 (2128) pixels
-0xBE7A, 0xCEDB, 0xCEDB, 0xCEBB, 0xCEBB, 0xCEDB, 0xCEDB, 0xCEDB, 0xCEDB, 0xCEDB, 0xCEDB, 0xCEDB, 0xCEDB, 0xCEDB, 0xCEDB, 0xCEDB,   // 0x0860 (2144) pixels
-0xCEDB, 0xCEDB, 0xCEBB, 0xCEBB, 0xCEBB, 0xCEBB, 0xCEBB, 0xC6BB, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xD6FC, 0x0000,   // 0x0870 (2160) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0880 (2176) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCEFC, 0xBE7A, 0xB67A, 0xBE7A, 0xBE7A, 0xB67A, 0xBE7A,   // 0x0890 (2192) pixels
-0xD71D, 0xE77D, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x08A0 (2208) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xD71C, 0xDF1C, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xD6FC, 0x0000,   // 0x08B0 (2224) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x08C0 (2240) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCEDB, 0xBE7A, 0xBE7A, 0xBE7A, 0xB65A, 0xB65A, 0xD6DB,   // 0x08D0 (2256) pixels
-0x0000, 0xAE7A, 0x7556, 0x6D36, 0x6D36, 0x6D36, 0x6D36, 0x6D36, 0x6D36, 0x6D36, 0x6D36, 0x6D36, 0x6D36, 0x6D36, 0x6D36, 0x6D36,   // 0x08E0 (2272) pixels
-0x6D36, 0x6D36, 0x6D36, 0x6D36, 0x6D36, 0x6D36, 0x7557, 0xBEDC, 0xEF7E, 0xC6BB, 0xBE7A, 0xBE7A, 0xBE7A, 0xBE7A, 0xCEBB, 0x0000,   // 0x08F0 (2288) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0900 (2304) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xDF3D, 0xC69A, 0xB67A, 0xB67A, 0xBE7A, 0xBE7A, 0xCEBB,   // 0x0910 (2320) pixels
-0x0000, 0x7556, 0x0391, 0x03B1, 0x03B1, 0x03B1, 0x03B1, 0x03B1, 0x03B1, 0x03B1, 0x03B1, 0x03B1, 0x03B1, 0x03B1, 0x03B1, 0x03B1,   // 0x0920 (2336) pixels
-0x03B1, 0x03B1, 0x03B1, 0x03B1, 0x03B1, 0x0391, 0x0BB1, 0x6CF5, 0x0000, 0xCEDB, 0xBE7A, 0xBE7A, 0xBE7A, 0xC67A, 0xDF5D, 0x0000,   // 0x0930 (2352) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0940 (2368) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCEFC, 0xBE7A, 0xB67A, 0xBE7A, 0xB65A, 0xCEDC,   // 0x0950 (2384) pixels
-0x0000, 0xAE7B, 0x54D5, 0x54D5, 0x4CD5, 0x54B5, 0x54B5, 0x54B5, 0x54B5, 0x54B5, 0x54B5, 0x54B5, 0x54B5, 0x54B5, 0x54B5, 0x54B5,   // 0x0960 (2400) pixels
-0x54B5, 0x54B5, 0x54B5, 0x54B5, 0x54B5, 0x54B5, 0x6515, 0xBEBB, 0xE77E, 0xC6BB, 0xBE7A, 0xBE7A, 0xBE7A, 0xCEDB, 0x0000, 0x0000,   // 0x0970 (2416) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0980 (2432) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xE77E, 0xD6FC, 0xC6BB, 0xCEBB, 0xCEBB, 0xCEDB,   // 0x0990 (2448) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x09A0 (2464) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xD6FC, 0xBE7A, 0xBE7A, 0xBE7A, 0xC6BB, 0xDF5D, 0x0000, 0x0000,   // 0x09B0 (2480) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x09C0 (2496) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x09D0 (2512) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x09E0 (2528) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCEDB, 0xBE7A, 0xB65A, 0xC69A, 0xDF3D, 0x0000, 0x0000, 0x0000,   // 0x09F0 (2544) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0A00 (2560) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xB69B, 0x7D57, 0x7557, 0x7557, 0x7557,   // 0x0A10 (2576) pixels
-0x7557, 0x7557, 0x7557, 0x7557, 0x7557, 0x7557, 0x7557, 0x7557, 0x7557, 0x7557, 0x7556, 0x7556, 0x7557, 0x7556, 0x7556, 0x7536,   // 0x0A20 (2592) pixels
-0xA65A, 0xCF3D, 0xD73D, 0x95F8, 0x7556, 0x7D56, 0x8D97, 0xE7BF, 0xEF9E, 0xC69B, 0xCEBB, 0xDF3D, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0A30 (2608) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0A40 (2624) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xD75D, 0x4C94, 0x0BD2, 0x0BD1, 0x0BD1, 0x0BD1,   // 0x0A50 (2640) pixels
-0x0BD1, 0x0BD1, 0x0BD1, 0x0BD1, 0x0BD1, 0x0BD1, 0x0BD1, 0x0BD1, 0x0BD1, 0x0BD1, 0x0BD1, 0x0BD1, 0x0BD1, 0x0BD1, 0x13D2, 0x13D2,   // 0x0A60 (2656) pixels
-0x3432, 0xCF1C, 0x9E19, 0x1BF2, 0x0BD1, 0x13D1, 0x13F2, 0x8577, 0x0000, 0xE75D, 0xDF1C, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0A70 (2672) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0A80 (2688) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xE79E, 0x7D77, 0x3C74, 0x3474, 0x3474, 0x3474,   // 0x0A90 (2704) pixels
-0x3474, 0x3474, 0x3474, 0x3474, 0x3474, 0x3474, 0x3474, 0x3474, 0x3474, 0x3474, 0x3474, 0x3474, 0x3474, 0x3C74, 0x3494, 0x4474,   // 0x0AA0 (2720) pixels
-0x6516, 0xB69A, 0x9DF9, 0x4CB4, 0x4C74, 0x3C74, 0x54B4, 0xA63A, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0AB0 (2736) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0AC0 (2752) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xC71D, 0x9E19, 0x9DF9, 0x9DF9, 0x9DF9,   // 0x0AD0 (2768) pixels
-0x9DF9, 0x9DF9, 0x9DF9, 0x9DF9, 0x9DF9, 0x9DF9, 0x9DF9, 0x9DF9, 0x9DF9, 0x9DF9, 0x9DF9, 0x9DF9, 0x9DF9, 0xA619, 0x9619, 0xA619,   // 0x0AE0 (2784) pixels
-0xC6DC, 0xE7BF, 0xEFDF, 0xAE5A, 0xA5F9, 0x9DF9, 0xAE5A, 0xEFDF, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0AF0 (2800) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0B00 (2816) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0B10 (2832) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0B20 (2848) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0B30 (2864) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0B40 (2880) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x8DD8, 0x3C52,   // 0x0B50 (2896) pixels
-0x3432, 0x2C33, 0x2C33, 0x2C33, 0x2C33, 0x2C33, 0x2C33, 0x2C33, 0x2C33, 0x2C33, 0x2C33, 0x2C33, 0x2C33, 0x2C33, 0x2C33, 0x2C33,   // 0x0B60 (2912) pixels
-0x2C33, 0x2C33, 0x3432, 0x6D15, 0xC6FC, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0B70 (2928) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0B80 (2944) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xBE9B, 0x7536, 0x13D2,   // 0x0B90 (2960) pixels
-0x1BD2, 0x13F2, 0x13F2, 0x13F2, 0x13F2, 0x13F2, 0x13F2, 0x13F2, 0x13F2, 0x13F2, 0x13F2, 0x13F2, 0x13F2, 0x13F2, 0x13F2, 0x13F2,   // 0x0BA0 (2976) pixels
-0x13F2, 0x13F2, 0x1BD1, 0x3C53, 0x8DB8, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0BB0 (2992) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0BC0 (3008) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xCF1D, 0x7557, 0x03B1,   // 0x0BD0 (3024) pixels
-0x0BD1, 0x13D2, 0x13D2, 0x13D2, 0x13D2, 0x13D2, 0x13D2, 0x13D2, 0x13D2, 0x13D2, 0x13D2, 0x13D2, 0x13D2, 0x13D2, 0x13D2, 0x13D2,   // 0x0BE0 (3040) pixels
-0x13D2, 0x0BD2, 0x0BB1, 0x3412, 0x74F5, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0BF0 (3056) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0C00 (3072) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xE7BE, 0xD73D,   // 0x0C10 (3088) pixels
-0xD71C, 0xD71C, 0xD71C, 0xD71C, 0xD71C, 0xD71C, 0xD71C, 0xD71C, 0xD71C, 0xD71C, 0xD71C, 0xD71C, 0xD71C, 0xD71C, 0xD71C, 0xD71C,   // 0x0C20 (3104) pixels
-0xD71C, 0xD6FC, 0xD71C, 0xD73D, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0C30 (3120) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0C40 (3136) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0C50 (3152) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0C60 (3168) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0C70 (3184) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0C80 (3200) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0C90 (3216) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0CA0 (3232) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0CB0 (3248) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0CC0 (3264) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0CD0 (3280) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0CE0 (3296) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0CF0 (3312) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0D00 (3328) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0D10 (3344) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0D20 (3360) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0D30 (3376) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0D40 (3392) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0D50 (3408) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0D60 (3424) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0D70 (3440) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0D80 (3456) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0D90 (3472) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0DA0 (3488) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0DB0 (3504) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0DC0 (3520) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0DD0 (3536) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0DE0 (3552) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0DF0 (3568) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0E00 (3584) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0E10 (3600) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0E20 (3616) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0E30 (3632) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0E40 (3648) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0E50 (3664) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0E60 (3680) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0E70 (3696) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0E80 (3712) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0E90 (3728) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0EA0 (3744) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0EB0 (3760) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0EC0 (3776) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0ED0 (3792) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0EE0 (3808) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0EF0 (3824) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0F00 (3840) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0F10 (3856) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0F20 (3872) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0F30 (3888) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0F40 (3904) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0F50 (3920) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0F60 (3936) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0F70 (3952) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0F80 (3968) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0F90 (3984) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0FA0 (4000) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0FB0 (4016) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0FC0 (4032) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0FD0 (4048) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0FE0 (4064) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x0FF0 (4080) pixels
-0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,   // 0x1000 (4096) pixels
-};
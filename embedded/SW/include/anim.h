@@ -0,0 +1,179 @@
+/**
+  ******************************************************************************
+  * @file    anim.h
+  * @author  Brian Schmalz
+  * @brief   Header file for keyframe LED animation engine
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ANIM_H__
+#define __ANIM_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+// Most keyframes one animation can have
+#define ANIM_MAX_KEYFRAMES      8
+
+// Frame rate used when an animation does not set one
+#define ANIM_DEFAULT_FPS        50
+
+// Returned by anim_NextFrameMs() when the animation never changes again
+#define ANIM_FOREVER            0xFFFFFFFF
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// How to get from one keyframe to the next
+typedef enum {
+  ANIM_EASE_STEP = 0,     // Jump to the next keyframe when its time comes
+  ANIM_EASE_LINEAR,       // Straight line blend
+  ANIM_EASE_IN_OUT,       // Sine shaped blend, slow at both ends
+} AnimEase_t;
+
+// How brightness is spread around the ring
+typedef enum {
+  ANIM_SHAPE_FLAT = 0,    // Every pixel the same
+  ANIM_SHAPE_SWIRL,       // Sine wave of brightness rotating around the ring
+  ANIM_SHAPE_CHASE,       // One bright pixel with a fading tail going around
+} AnimShape_t;
+
+// Alert severities, each with its own palette and motion
+typedef enum {
+  ANIM_SEVERITY_NONE = 0,
+  ANIM_SEVERITY_INFO,
+  ANIM_SEVERITY_ADVISORY,
+  ANIM_SEVERITY_WATCH,
+  ANIM_SEVERITY_WARNING,
+} AnimSeverity_t;
+
+// One point on the animation's timeline
+typedef struct {
+  uint32_t timeMs;        // When this keyframe is reached, from start of loop
+  uint8_t red;
+  uint8_t green;
+  uint8_t blue;
+  uint8_t level;          // Brightness 0-255, gamma corrected when shown
+  uint8_t ease;           // AnimEase_t used from this keyframe to the next
+} AnimKeyframe_t;
+
+// A complete animation. Keyframes must be in time order, starting at 0.
+typedef struct {
+  AnimKeyframe_t keyframes[ANIM_MAX_KEYFRAMES];
+  uint8_t keyframeCount;
+  uint32_t periodMs;      // Length of one loop (0 = hold the first keyframe)
+  uint8_t shape;          // AnimShape_t
+  uint32_t rotationMs;    // Time for the shape to go once around the ring
+  uint8_t fps;            // Frame rate for the smooth parts of the animation
+} Animation_t;
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Make a single solid color that never changes
+  * @param  anim : Animation to fill in
+  * @param  red, green, blue : Color, 0 to 255
+  * @retval none
+  */
+void anim_PresetSolid(Animation_t * anim, uint8_t red, uint8_t green, uint8_t blue);
+
+/**
+  * @brief  Make all LEDs blink on and off together
+  * @param  anim : Animation to fill in
+  * @param  red, green, blue : Color when on, 0 to 255
+  * @param  onTime : milliseconds on
+  * @param  offTime : milliseconds off
+  * @retval none
+  */
+void anim_PresetBlink(Animation_t * anim, uint8_t red, uint8_t green, uint8_t blue, uint32_t onTime, uint32_t offTime);
+
+/**
+  * @brief  Make all LEDs fade smoothly up and down together
+  * @param  anim : Animation to fill in
+  * @param  red, green, blue : Color at full brightness, 0 to 255
+  * @param  periodMs : milliseconds for one full breath
+  * @retval none
+  */
+void anim_PresetBreathe(Animation_t * anim, uint8_t red, uint8_t green, uint8_t blue, uint32_t periodMs);
+
+/**
+  * @brief  Make a band of brightness swirl around the ring
+  * @param  anim : Animation to fill in
+  * @param  red, green, blue : Color, 0 to 255
+  * @param  rotationMs : milliseconds for one trip around the ring
+  * @retval none
+  */
+void anim_PresetSwirl(Animation_t * anim, uint8_t red, uint8_t green, uint8_t blue, uint32_t rotationMs);
+
+/**
+  * @brief  Make one pixel with a fading tail chase around the ring
+  * @param  anim : Animation to fill in
+  * @param  red, green, blue : Color, 0 to 255
+  * @param  rotationMs : milliseconds for one trip around the ring
+  * @retval none
+  */
+void anim_PresetChase(Animation_t * anim, uint8_t red, uint8_t green, uint8_t blue, uint32_t rotationMs);
+
+/**
+  * @brief  Make the standard animation for an alert severity
+  * @param  anim : Animation to fill in
+  * @param  severity : AnimSeverity_t
+  * @retval true if the severity is known
+  */
+bool anim_PresetSeverity(Animation_t * anim, uint8_t severity);
+
+/**
+  * @brief  Compute the colors of every pixel at one point in time.
+  *         Integer only, a 16 pixel frame takes a few microseconds.
+  * @param  anim : Animation to render
+  * @param  elapsedMs : Time since the animation started
+  * @param  frame : Filled in with numPixels red, green, blue triples
+  * @param  numPixels : Number of pixels in the ring
+  * @retval none
+  */
+void anim_Render(const Animation_t * anim, uint32_t elapsedMs, uint8_t frame[][3], int numPixels);
+
+/**
+  * @brief  Work out when the animation next needs a new frame
+  * @param  anim : Animation being shown
+  * @param  elapsedMs : Time of the frame just shown, since the animation started
+  * @retval Milliseconds until the next frame, or ANIM_FOREVER if the
+  *         animation will not change again
+  */
+uint32_t anim_NextFrameMs(const Animation_t * anim, uint32_t elapsedMs);
+
+#endif /* __ANIM_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
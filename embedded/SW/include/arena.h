@@ -0,0 +1,142 @@
+/**
+  ******************************************************************************
+  * @file    arena.h
+  * @author  Brian Schmalz
+  * @brief   Header file for the fixed memory POST bodies are parsed in
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+#include <ArduinoJson.h>
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// Bookkeeping for one request arena, and where its parts are
+typedef struct {
+  bool inUse;
+  bool overflow;            // The body did not fit
+  size_t length;            // Body bytes received so far
+  size_t size;              // Room for the body, not counting the terminator
+  char * body;
+  JsonDocument * doc;
+} ArenaHeader_t;
+
+// Memory for one POST request to a route: room for the biggest body the
+// route accepts and for the JSON document parsed in place from it. Strings
+// in the document point into the body, so it only holds the tree.
+template <size_t BodySize, size_t DocSize>
+struct RequestArena {
+  RequestArena()
+  {
+    header.inUse = false;
+    header.size = BodySize;
+    header.body = body;
+    header.doc = &doc;
+  }
+  ArenaHeader_t header;
+  char body[BodySize + 1];
+  StaticJsonDocument<DocSize> doc;
+};
+
+// Arena of each POST route. The documents have room for every field the
+// route knows plus a few unknown ones.
+typedef RequestArena<256, JSON_OBJECT_SIZE(16)> LedArena_t;
+typedef RequestArena<512, JSON_OBJECT_SIZE(12)> LcdArena_t;
+typedef RequestArena<128, JSON_OBJECT_SIZE(8)> IconArena_t;
+typedef RequestArena<1024, JSON_OBJECT_SIZE(8) + JSON_OBJECT_SIZE(12) + JSON_OBJECT_SIZE(16) + JSON_OBJECT_SIZE(8)> StateArena_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Take a free arena from a pool for a new body
+  * @param  pool : the route's arenas
+  * @param  count : number of arenas in pool
+  * @retval the arena, emptied, or NULL if every one is in use
+  */
+template <typename Arena>
+ArenaHeader_t * arena_Take(Arena * pool, int count)
+{
+  for (int i = 0; i < count; i++)
+  {
+    ArenaHeader_t * arena = &pool[i].header;
+    if (!arena->inUse)
+    {
+      arena->inUse = true;
+      arena->overflow = false;
+      arena->length = 0;
+      return arena;
+    }
+  }
+  return NULL;
+}
+
+/**
+  * @brief  Give an arena back to its pool
+  * @param  arena : arena from arena_Take()
+  * @retval none
+  */
+void arena_Release(ArenaHeader_t * arena);
+
+/**
+  * @brief  Copy one chunk of a body into an arena. Chunks must arrive in
+  *         order. A body bigger than the arena marks it overflowed and is
+  *         dropped; the body is zero terminated once all of it is in.
+  * @param  arena : arena from arena_Take()
+  * @param  data : this chunk of the body
+  * @param  len : number of bytes in this chunk
+  * @param  index : offset of this chunk within the body
+  * @param  total : total length of the body
+  * @retval none
+  */
+void arena_Append(ArenaHeader_t * arena, const uint8_t * data, size_t len, size_t index, size_t total);
+
+/**
+  * @brief  Parse an arena's complete body in place into its document. Never
+  *         allocates: the tree goes in the arena's document and strings
+  *         stay in the body.
+  * @param  arena : arena holding a complete body
+  * @retval result of deserializeJson()
+  */
+DeserializationError arena_Parse(ArenaHeader_t * arena);
+
+#endif /* __ARENA_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -0,0 +1,157 @@
+/**
+  ******************************************************************************
+  * @file    bme280.h
+  * @author  Brian Schmalz
+  * @brief   Register level BME280 driver
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __BME280_H__
+#define __BME280_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <Wire.h>
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// Measurement mode (ctrl_meas mode bits)
+typedef enum {
+  BME280_MODE_SLEEP = 0,
+  BME280_MODE_FORCED = 1,       // One measurement per read(), then back to sleep
+  BME280_MODE_NORMAL = 3        // Free running, read() just fetches the latest result
+} BME280Mode_t;
+
+// Oversampling of one channel (osrs_x bits)
+typedef enum {
+  BME280_OVERSAMPLE_SKIP = 0,   // Channel not measured
+  BME280_OVERSAMPLE_X1,
+  BME280_OVERSAMPLE_X2,
+  BME280_OVERSAMPLE_X4,
+  BME280_OVERSAMPLE_X8,
+  BME280_OVERSAMPLE_X16
+} BME280Oversample_t;
+
+// IIR filter coefficient for temperature and pressure (config filter bits)
+typedef enum {
+  BME280_FILTER_OFF = 0,
+  BME280_FILTER_2,
+  BME280_FILTER_4,
+  BME280_FILTER_8,
+  BME280_FILTER_16
+} BME280Filter_t;
+
+// Time between measurements in normal mode (config t_sb bits)
+typedef enum {
+  BME280_STANDBY_0_5_MS = 0,
+  BME280_STANDBY_62_5_MS,
+  BME280_STANDBY_125_MS,
+  BME280_STANDBY_250_MS,
+  BME280_STANDBY_500_MS,
+  BME280_STANDBY_1000_MS,
+  BME280_STANDBY_10_MS,
+  BME280_STANDBY_20_MS
+} BME280Standby_t;
+
+typedef struct {
+  BME280Mode_t mode;
+  BME280Oversample_t temperature;
+  BME280Oversample_t pressure;
+  BME280Oversample_t humidity;
+  BME280Filter_t filter;
+  BME280Standby_t standby;      // Only used in normal mode
+} BME280Config_t;
+
+// One compensated sample, in the fixed point formats of the Bosch reference code
+typedef struct {
+  int32_t temperature;          // 0.01 deg C
+  uint32_t pressure;            // Pa, Q24.8
+  uint32_t humidity;            // %RH, Q22.10
+  uint32_t busUs;               // Time spent on I2C transactions for this sample
+} BME280Sample_t;
+
+/**
+  * @brief  BME280 temperature/pressure/humidity sensor on I2C.
+  *         Each read() fetches all eight data registers (0xF7 to 0xFE) in
+  *         one burst and compensates them with the integer formulas from
+  *         the datasheet, computing t_fine once for all three channels.
+  */
+class BME280
+{
+  public:
+    BME280(TwoWire & wire, uint8_t address);
+
+    // Check the chip ID, load calibration and apply config. Returns false on failure.
+    bool begin(const BME280Config_t & config);
+
+    // Change mode, oversampling and filter settings
+    bool configure(const BME280Config_t & config);
+
+    // Take (forced mode) or fetch (normal mode) one sample. Returns false on failure.
+    bool read(BME280Sample_t * sample);
+
+    // Worst case conversion time in microseconds for the current config
+    uint32_t measureTimeUs(void) const;
+
+  private:
+    bool readRegisters(uint8_t reg, uint8_t * data, uint8_t length);
+    bool writeRegister(uint8_t reg, uint8_t value);
+    bool readCalibration(void);
+    int32_t compensateTemperature(int32_t adc);
+    uint32_t compensatePressure(int32_t adc);
+    uint32_t compensateHumidity(int32_t adc);
+
+    TwoWire * wire;
+    uint8_t address;
+    BME280Config_t config;
+    uint32_t busUs;               // I2C time accumulated by the current read()
+    int32_t tFine;                // Fine temperature shared by the pressure and humidity formulas
+
+    // Calibration (trimming) parameters
+    uint16_t digT1;
+    int16_t digT2, digT3;
+    uint16_t digP1;
+    int16_t digP2, digP3, digP4, digP5, digP6, digP7, digP8, digP9;
+    uint8_t digH1, digH3;
+    int16_t digH2, digH4, digH5;
+    int8_t digH6;
+};
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+#endif /* __BME280_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -0,0 +1,126 @@
+/**
+  ******************************************************************************
+  * @file    boot.h
+  * @author  Brian Schmalz
+  * @brief   Header file for boot sequencing and timing
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __BOOT_H__
+#define __BOOT_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "topology.h"
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// Points in the boot sequence that are timed. Each is reached once.
+typedef enum {
+  BOOT_STAGE_SETUP = 0,         // setup() entered
+  BOOT_STAGE_WIFI_START,        // Association started
+  BOOT_STAGE_LED,               // led_Init() done
+  BOOT_STAGE_SENSOR,            // sensor_Init() done (sensor probed, log mounted)
+  BOOT_STAGE_LCD,               // lcd_Init() done
+  BOOT_STAGE_RENDER,            // Render task owns the LCD and LEDs
+  BOOT_STAGE_WIFI_CONNECTED,    // Associated with the access point
+  BOOT_STAGE_GOT_IP,            // DHCP gave us an address
+  BOOT_STAGE_SERVER,            // HTTP server listening
+  BOOT_STAGE_FIRST_REQUEST,     // First HTTP request arrived
+  BOOT_STAGE_COUNT
+} BootStage_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Exported macros -----------------------------------------------------------*/
+
+// Event bit for a stage, for boot_Wait()
+#define BOOT_BIT(stage)         (1UL << (stage))
+
+// boot_Wait() timeout that never expires
+#define BOOT_WAIT_FOREVER       0xFFFFFFFFUL
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Initialize the boot module and mark BOOT_STAGE_SETUP. Call first
+  *         thing in setup().
+  * @param  none
+  * @retval none
+  */
+void boot_Init(void);
+
+/**
+  * @brief  Record that a stage has been reached. Only the first call for
+  *         a stage counts. Safe to call from any task.
+  * @param  stage : stage reached
+  * @retval none
+  */
+void boot_Mark(BootStage_t stage);
+
+/**
+  * @brief  Run an init function in a task of its own, so it overlaps with
+  *         the rest of the boot. The stage is marked when it returns, and
+  *         the task then deletes itself.
+  * @param  task : which task to run it in (sets its core, priority and stack)
+  * @param  init : init function to run
+  * @param  stage : stage to mark when init returns
+  * @retval none
+  */
+void boot_Start(TaskId_t task, void (*init)(void), BootStage_t stage);
+
+/**
+  * @brief  Wait until all the given stages have been reached
+  * @param  stages : BOOT_BIT() of each stage to wait for
+  * @param  timeoutMs : longest time to wait, or BOOT_WAIT_FOREVER
+  * @retval true if all of the stages were reached, false on timeout
+  */
+bool boot_Wait(uint32_t stages, uint32_t timeoutMs);
+
+/**
+  * @brief  When a stage was reached
+  * @param  stage : the stage
+  * @retval esp_timer_get_time() when the stage was reached (time since
+  *         power on/reset in microseconds), or 0 if not reached yet
+  */
+int64_t boot_GetStageUs(BootStage_t stage);
+
+/**
+  * @brief  Name of a stage, for reporting ("setup", "got_ip", ...)
+  * @param  stage : the stage
+  * @retval stage name
+  */
+const char * boot_GetStageName(BootStage_t stage);
+
+#endif /* __BOOT_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -0,0 +1,100 @@
+/**
+  ******************************************************************************
+  * @file    envcache.h
+  * @author  Brian Schmalz
+  * @brief   Header file for pre-serialized sensor response cache
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ENVCACHE_H__
+#define __ENVCACHE_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+// Largest serialized response for any one resource
+#define ENVCACHE_BODY_SIZE  256
+
+// Room for a quoted "<boot id>-<version>" ETag
+#define ENVCACHE_ETAG_SIZE  24
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// The sensor resources that have a cached JSON response
+typedef enum {
+  ENV_TEMPERATURE = 0,    // /temperature
+  ENV_HUMIDITY,           // /humidity
+  ENV_PRESSURE,           // /pressure
+  ENV_ALL,                // /env
+  ENV_COUNT
+} EnvResource_t;
+
+// Copy of one cached response, so it stays valid however long it is kept
+typedef struct {
+  char body[ENVCACHE_BODY_SIZE];  // JSON response body (zero terminated)
+  size_t length;                  // Number of bytes in body
+  char etag[ENVCACHE_ETAG_SIZE];  // Quoted ETag for this version of the body
+  uint32_t version;               // Incremented every time a sample changes a body
+} EnvResponse_t;
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Build the JSON responses for a new sensor sample and make them
+  *         the current version, unless they are the same as the current
+  *         ones, which then keep their version and ETag. Call from the
+  *         sensor task once per sample.
+  * @param  temperature : Latest temperature reading
+  * @param  humidity : Latest humidity reading
+  * @param  pressure : Latest pressure reading
+  * @retval none
+  */
+void envcache_Publish(float temperature, float humidity, float pressure);
+
+/**
+  * @brief  Copy out the current cached response for one resource. Safe to
+  *         call from any task while the sensor task publishes.
+  * @param  which : Resource to get the response for
+  * @param  response : Filled in with a copy of the body, length, ETag and
+  *         version
+  * @retval true if a sample has been published, false if the cache is empty
+  */
+bool envcache_Get(EnvResource_t which, EnvResponse_t * response);
+
+#endif /* __ENVCACHE_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -56,8 +56,9 @@
 void handlers_Init(void);
 
 /**
-  * @brief  Check for new http requests, handler them
-  *         Call every time through main loop
+  * @brief  Service the webserver from the main loop
+  *         Requests are handled by the async server's own task, so this
+  *         only sleeps. Kept so loop() does not need to change.
   * @param  none
   * @retval none
   */
@@ -0,0 +1,155 @@
+/**
+  ******************************************************************************
+  * @file    history.h
+  * @author  Brian Schmalz
+  * @brief   In RAM ring buffer of sensor samples
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HISTORY_H__
+#define __HISTORY_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "tscodec.h"
+#include "tslog.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// Bytes of RAM for stored samples. Set with -DHISTORY_BUDGET=... in
+// platformio.ini build_flags. Every sample after the first in a block
+// costs 6 bytes, so 32 KB holds about an hour and a half at 1 Hz.
+#ifndef HISTORY_BUDGET
+#define HISTORY_BUDGET          32768
+#endif
+
+// Channels stored for every sample: temperature, humidity, pressure
+#define HISTORY_CHANNELS        3
+
+// Samples per block, including the full precision first sample
+#define HISTORY_BLOCK_SAMPLES   128
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// One sample (or the average of a bucket of samples) in fixed point
+typedef TsSample_t HistorySample_t;
+
+/**
+  * @brief  A run of evenly spaced samples. The first is stored in full, the
+  *         rest as 16 bit differences from the sample before. A block ends
+  *         early if a sample arrives off schedule or a difference does not
+  *         fit in 16 bits.
+  */
+typedef struct {
+  int64_t baseMs;                                             // Time of the first sample
+  int32_t base[HISTORY_CHANNELS];                             // First sample
+  uint32_t id;                                                // Counts up for every block started
+  uint16_t count;                                             // Samples in the block
+  int16_t delta[HISTORY_BLOCK_SAMPLES - 1][HISTORY_CHANNELS]; // Sample n+1 minus sample n
+} HistoryBlock_t;
+
+// State of one range query. Filled in by history_BeginQuery().
+typedef struct {
+  int64_t fromMs;
+  int64_t toMs;
+  int64_t stepMs;
+  TslogCursor_t log;            // Reads the part of the range older than RAM holds
+  bool inLog;                   // Still reading from the log
+  uint32_t block;               // Id of the next block to copy
+  uint16_t index;               // Next sample in the copied block
+  int32_t value[HISTORY_CHANNELS];  // Sample at index - 1
+  HistoryBlock_t copy;          // Private copy, so the writer never waits on a reader
+  bool loaded;                  // copy holds a block
+  int64_t bucketMs;             // Start of the bucket being averaged
+  int64_t sum[HISTORY_CHANNELS];
+  uint32_t n;                   // Samples in the bucket so far
+} HistoryQuery_t;
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Allocate the sample store (PSRAM if present) and open the
+  *         sample log on flash
+  * @param  periodMs : time between samples
+  * @retval true if the store was allocated
+  */
+bool history_Init(uint32_t periodMs);
+
+/**
+  * @brief  Current time for sample timestamps: Unix time in ms once the
+  *         clock has been set over SNTP, time since boot before that
+  * @retval time in ms
+  */
+int64_t history_Now(void);
+
+/**
+  * @brief  Store one sample in RAM and in the sample log. Only the sensor
+  *         task calls this.
+  * @param  sample : the sample, time from history_Now()
+  * @retval none
+  */
+void history_Add(const HistorySample_t * sample);
+
+/**
+  * @brief  Start a query for the samples from fromMs to toMs (inclusive),
+  *         averaged over buckets of stepMs starting at fromMs
+  * @param  query : query state to set up
+  * @param  fromMs : start of the range
+  * @param  toMs : end of the range
+  * @param  stepMs : bucket size, at least 1
+  * @retval none
+  */
+void history_BeginQuery(HistoryQuery_t * query, int64_t fromMs, int64_t toMs, int64_t stepMs);
+
+/**
+  * @brief  Get the next non-empty bucket of a query, oldest first. The
+  *         samples come from the log on flash for times before the oldest
+  *         sample in RAM, then from RAM. Samples overwritten in RAM while
+  *         the query runs are skipped.
+  * @param  query : query started with history_BeginQuery()
+  * @param  sample : filled in with the bucket start time and average values
+  * @retval true if a bucket was returned, false once the range is done
+  */
+bool history_NextBucket(HistoryQuery_t * query, HistorySample_t * sample);
+
+/**
+  * @brief  Time of the oldest stored sample, in RAM or in the log
+  * @param  timeMs : filled in with the time
+  * @retval false if nothing has been stored yet
+  */
+bool history_GetOldest(int64_t * timeMs);
+
+#endif /* __HISTORY_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
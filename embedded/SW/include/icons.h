@@ -0,0 +1,109 @@
+/**
+  ******************************************************************************
+  * @file    icons.h
+  * @author  Brian Schmalz
+  * @brief   Header file for the compressed icon store
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ICONS_H__
+#define __ICONS_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// How an icon's pixels are stored
+typedef enum {
+  ICON_ENCODING_RLE = 0         // Run length encoded RGB565, see icons.cpp
+} IconEncoding_t;
+
+// Describes one icon in flash. The descriptors are generated into
+// icontable.h by scripts/icon_convert.py.
+typedef struct {
+  const char * name;            // Weather code, i.e. "a02d"
+  uint8_t width;
+  uint8_t height;
+  uint8_t encoding;             // IconEncoding_t
+  uint32_t offset;              // Where the icon's data starts in IconData
+  uint32_t size;                // Bytes of data
+} IconAsset_t;
+
+// Where decoding of an icon has got to
+typedef struct {
+  const IconAsset_t * asset;
+  uint32_t offset;              // Next byte of the icon's data to read
+  uint8_t row;                  // Next row to decode
+} IconDecoder_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+// Color of transparent pixels in decoded rows. No opaque pixel uses it.
+#define ICON_TRANSPARENT    0xF81F
+
+// Widest icon in the store, so a decoded row always fits in this many pixels
+#define ICON_MAX_WIDTH      64
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Look up an icon by name. Takes one hash and one string compare.
+  * @param  name : Name of the icon (i.e. "a02d")
+  * @retval Pointer to the icon, or NULL if there is no icon with that name
+  */
+const IconAsset_t * icons_Find(const char * name);
+
+/**
+  * @brief  Get ready to decode an icon from its first row
+  * @param  decoder : Decoder state to set up
+  * @param  asset : Icon to decode
+  * @retval none
+  */
+void icons_BeginDecode(IconDecoder_t * decoder, const IconAsset_t * asset);
+
+/**
+  * @brief  Decode the next row of an icon into RGB565 pixels. Transparent
+  *         pixels are set to ICON_TRANSPARENT.
+  * @param  decoder : Decoder set up by icons_BeginDecode()
+  * @param  line : Where to put the pixels, at least the icon's width long
+  * @retval true if a row was decoded, false if there are no more rows or the
+  *         data is corrupt
+  */
+bool icons_DecodeRow(IconDecoder_t * decoder, uint16_t * line);
+
+#endif /* __ICONS_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
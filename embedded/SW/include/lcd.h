@@ -49,21 +49,30 @@
 /* Exported functions --------------------------------------------------------*/
 
 /**
-  * @brief  Display the 'Waiting for data' message on the display
+  * @brief  Start composing a frame. Drawing calls made until the matching
+  *         lcd_EndFrame() reach the panel together in one update. Calls
+  *         nest, and every drawing function below wraps itself in one.
+  *         Waits for the previous frame's DMA push to finish.
   * @param  none
   * @retval none
   */
-void lcd_DisplayWaiting(void);
+void lcd_BeginFrame(void);
 
 /**
-  * @brief  Display the IP address on the display
+  * @brief  Finish composing a frame and start pushing the rows that changed
+  *         to the panel with DMA. Returns without waiting for the push,
+  *         which holds the SPI bus until the next lcd_BeginFrame(), so
+  *         every frame after lcd_Init() must come from the same task.
   * @param  none
   * @retval none
   */
- void lcd_DisplayIP(void);
+void lcd_EndFrame(void);
 
 /**
-  * @brief  Print the four strings as four lines of text on the display
+  * @brief  Print the four strings as four lines of text on the display.
+  *         Only lines whose text changed since the last call (or that an
+  *         icon was drawn over) are sent to the display, so repeating the
+  *         same text costs no SPI traffic at all.
   * @param  text1 : First line of text
   * @param  text2 : Second line of text
   * @param  text3 : Third line of text
@@ -73,7 +82,33 @@ void lcd_DisplayWaiting(void);
 void lcd_printTextLines(const char * text1, const char * text2, const char * text3, const char * text4);
 
 /**
-  * @brief  Initialize the LCD module
+  * @brief  Check if an icon with the given name can be drawn
+  * @param  iconName : Name of the icon (i.e. "a02d")
+  * @retval true if the icon is known, false otherwise
+  */
+bool lcd_IsIconKnown(const char * iconName);
+
+/**
+  * @brief  Draw a named icon on the display with its top left corner at x, y
+  * @param  iconName : Name of the icon (i.e. "a02d")
+  * @param  x : X coordinate of the top left corner of the icon
+  * @param  y : Y coordinate of the top left corner of the icon
+  * @retval true if the icon was drawn, false if the name is not known
+  */
+bool lcd_DrawIcon(const char * iconName, int x, int y);
+
+/**
+  * @brief  Set aside RAM for the full screen frame. Call before WiFi starts,
+  *         while the heap still has a big enough free block. Quick, unlike
+  *         lcd_Init(), which can then run in parallel with WiFi.
+  * @param  none
+  * @retval none
+  */
+void lcd_Reserve(void);
+
+/**
+  * @brief  Initialize the LCD module. Waits for its own first frame to
+  *         reach the panel, so it may run in a task that ends afterwards.
   * @param  none
   * @retval none
   */
@@ -39,6 +39,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdint.h>
+#include "anim.h"
 
 /* Exported types ------------------------------------------------------------*/ 
 
@@ -51,18 +52,43 @@
 /* Exported functions --------------------------------------------------------*/
 
 /**
-  * @brief  Set new LED effect
+  * @brief  Set new LED effect. Each effect is a preset of the animation engine.
   * @param  red : From 0 to 255 - red brightness
   * @param  green : From 0 to 255 - blue brightness
   * @param  blue : From 0 to 255 - gree brightness
-  * @param  newEffect : 0 = Turn LEDs off
+  * @param  newEffect : 0 = Solid color (all 0 turns LEDs off)
   * @param  newEffect : 1 = Blink (use onTime and offTime)
-  * @param  onTime : in milliseconds, used when newEffect = 1. Time LEDs stay on
+  * @param  newEffect : 2 = Breathe (onTime is the full breath period)
+  * @param  newEffect : 3 = Swirl (onTime is the time for one rotation)
+  * @param  newEffect : 4 = Chase (onTime is the time for one rotation)
+  * @param  onTime : in milliseconds, see newEffect
   * @param  offTime : in milliseconds, used when newEffect = 1. Time LEDs stay off
+  * @note   Only posts the new animation to the LED effects task and returns
   * @retval none
   */
 void led_changeEffect(uint8_t red, uint8_t green, uint8_t blue, uint8_t newEffect, uint32_t onTime, uint32_t offTime);
 
+/**
+  * @brief  Show the standard palette and motion for an alert severity
+  * @param  severity : AnimSeverity_t (info, advisory, watch, warning)
+  * @retval true if the severity is known
+  */
+bool led_changeSeverity(uint8_t severity);
+
+/**
+  * @brief  Play any animation on the LED ring, replacing the current one
+  * @param  anim : Animation to play (copied). fps of 0 uses the current frame rate.
+  * @retval none
+  */
+void led_playAnimation(const Animation_t * anim);
+
+/**
+  * @brief  Set the frame rate used by animations started after this call
+  * @param  fps : Frames per second, 0 leaves the frame rate unchanged
+  * @retval none
+  */
+void led_setFrameRate(uint8_t fps);
+
 /**
   * @brief  Initialize the LED module
   * @param  none
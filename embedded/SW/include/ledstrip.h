@@ -0,0 +1,107 @@
+/**
+  ******************************************************************************
+  * @file    ledstrip.h
+  * @author  Brian Schmalz
+  * @brief   Header file for non-blocking RMT driven WS2812 LED strip
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __LEDSTRIP_H__
+#define __LEDSTRIP_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <driver/rmt.h>
+
+/* Exported types ------------------------------------------------------------*/ 
+
+/**
+  * @brief  WS2812 (GRB, 800 kHz) LED strip driven by the RMT peripheral.
+  *         Offers the same operations as the Adafruit_NeoPixel object it
+  *         replaces, but show() only converts the frame into RMT items and
+  *         starts the transfer. The RMT streams it out in the background
+  *         from one of two item buffers while the next frame is prepared in
+  *         the other, so the CPU and interrupts are never held up for the
+  *         length of the frame.
+  */
+class LEDStrip
+{
+  public:
+    LEDStrip(uint16_t numPixels, uint8_t pin, rmt_channel_t channel);
+
+    // Allocate buffers and set up the RMT channel. Returns false on failure.
+    bool begin(void);
+
+    // Set one pixel in the frame being prepared
+    void setPixelColor(uint16_t n, uint8_t red, uint8_t green, uint8_t blue);
+    void setPixelColor(uint16_t n, uint32_t color);
+
+    // Set every pixel in the frame being prepared
+    void fill(uint32_t color);
+    void clear(void);
+
+    // Start sending the prepared frame. Returns without waiting for it.
+    void show(void);
+
+    // Number of pixels in the strip
+    uint16_t numPixels(void) const;
+
+    // Duration in microseconds of the last completed frame transfer
+    uint32_t lastTransmitUs(void) const;
+
+    // Pack a color the same way Adafruit_NeoPixel::Color() does
+    static uint32_t Color(uint8_t red, uint8_t green, uint8_t blue);
+
+  private:
+    static void transmitDone(rmt_channel_t channel, void * arg);
+
+    uint16_t count;
+    uint8_t pin;
+    rmt_channel_t channel;
+    uint8_t * pixels;             // count * 3 bytes, GRB order
+    rmt_item32_t * items[2];      // Double buffered RMT items, 24 per pixel
+    uint8_t back;                 // Item buffer the next frame is built in
+    bool sending;
+    volatile int64_t startUs;
+    volatile int64_t endUs;
+    volatile uint32_t transmitUs;
+};
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+#endif /* __LEDSTRIP_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -0,0 +1,121 @@
+/**
+  ******************************************************************************
+  * @file    logger.h
+  * @author  Brian Schmalz
+  * @brief   Header file for asynchronous ring buffer logger
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __LOGGER_H__
+#define __LOGGER_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/ 
+
+/* Exported constants --------------------------------------------------------*/
+
+// Log levels. Messages above LOGGER_LEVEL are compiled out completely.
+#define LOGGER_LEVEL_NONE   0
+#define LOGGER_LEVEL_ERROR  1
+#define LOGGER_LEVEL_WARN   2
+#define LOGGER_LEVEL_INFO   3
+#define LOGGER_LEVEL_DEBUG  4
+
+// Set with -DLOGGER_LEVEL=... in platformio.ini build_flags
+#ifndef LOGGER_LEVEL
+#define LOGGER_LEVEL        LOGGER_LEVEL_INFO
+#endif
+
+// Number of messages the ring can hold (power of two) and the longest
+// message kept, including the timestamp and level prefix
+#define LOGGER_SLOTS        32
+#define LOGGER_MSG_SIZE     120
+
+/* Exported macros -----------------------------------------------------------*/
+
+// printf style logging. Arguments are not evaluated when a level is disabled.
+#if LOGGER_LEVEL >= LOGGER_LEVEL_ERROR
+#define LOGGER_ERROR(...)   logger_Write('E', __VA_ARGS__)
+#else
+#define LOGGER_ERROR(...)   do {} while (0)
+#endif
+
+#if LOGGER_LEVEL >= LOGGER_LEVEL_WARN
+#define LOGGER_WARN(...)    logger_Write('W', __VA_ARGS__)
+#else
+#define LOGGER_WARN(...)    do {} while (0)
+#endif
+
+#if LOGGER_LEVEL >= LOGGER_LEVEL_INFO
+#define LOGGER_INFO(...)    logger_Write('I', __VA_ARGS__)
+#else
+#define LOGGER_INFO(...)    do {} while (0)
+#endif
+
+#if LOGGER_LEVEL >= LOGGER_LEVEL_DEBUG
+#define LOGGER_DEBUG(...)   logger_Write('D', __VA_ARGS__)
+#else
+#define LOGGER_DEBUG(...)   do {} while (0)
+#endif
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Queue one formatted message for the UART. Never blocks: if the
+  *         ring buffer is full the message is dropped and counted.
+  *         Use the LOGGER_xxx macros rather than calling this directly.
+  * @param  level : Single letter level tag printed with the message
+  * @param  format : printf style format string
+  * @retval none
+  */
+void logger_Write(char level, const char * format, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+  * @brief  Return the number of messages dropped because the buffer was full
+  * @param  none
+  * @retval Total dropped message count since boot
+  */
+uint32_t logger_GetDropped(void);
+
+/**
+  * @brief  Initialize the logger and start the UART drain task.
+  *         Call right after Serial.begin(), before any other module logs.
+  * @param  none
+  * @retval none
+  */
+void logger_Init(void);
+
+#endif /* __LOGGER_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -0,0 +1,192 @@
+/**
+  ******************************************************************************
+  * @file    metrics.h
+  * @author  Brian Schmalz
+  * @brief   Header file for latency histograms and counters
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __METRICS_H__
+#define __METRICS_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// Timed operations. Each one gets its own latency histogram.
+typedef enum {
+  METRIC_JSON_PARSE = 0,        // deserializeJson() of a POST body
+  METRIC_HANDLER_TEMPERATURE,   // /temperature handler
+  METRIC_HANDLER_HUMIDITY,      // /humidity handler
+  METRIC_HANDLER_PRESSURE,      // /pressure handler
+  METRIC_HANDLER_ENV,           // /env handler
+  METRIC_HANDLER_LED,           // /led handler
+  METRIC_HANDLER_LCD,           // /lcd handler
+  METRIC_HANDLER_ICON,          // /icon handler
+  METRIC_HANDLER_STATE,         // /state handler
+  METRIC_HANDLER_HISTORY,       // /history handler, up to the start of streaming
+  METRIC_LCD_TEXT,              // lcd_printTextLines()
+  METRIC_LCD_FRAME,             // Composing an LCD frame and starting its push
+  METRIC_LED_SHOW,              // pixels.show()
+  METRIC_LED_TRANSMIT,          // RMT transfer of one LED frame
+  METRIC_SENSOR_READ,           // BME280 reads in readData()
+  METRIC_SENSOR_I2C,            // I2C bus time of one BME280 sample
+  METRIC_LOG_WRITE,             // Appending one block to the sample log on flash
+  METRIC_FIRST_PIXEL_AMBIENT,   // Submit to first LCD frame/LED change, ambient content
+  METRIC_FIRST_PIXEL_ADVISORY,  // Same for advisories
+  METRIC_FIRST_PIXEL_WATCH,     // Same for watches
+  METRIC_FIRST_PIXEL_WARNING,   // Same for warnings
+  METRIC_TIMER_COUNT
+} MetricTimer_t;
+
+// Event counters
+typedef enum {
+  METRIC_REQUESTS = 0,          // HTTP requests handled
+  METRIC_ERRORS,                // HTTP requests answered with an error
+  METRIC_LOOPS,                 // Arduino loop() iterations
+  METRIC_LCD_FRAMES,            // LCD frames pushed to the panel
+  METRIC_LCD_LINES_DRAWN,       // Text lines sent to the LCD
+  METRIC_LCD_LINES_SKIPPED,     // Text lines left alone because they were unchanged
+  METRIC_RASTER_HITS,           // Icons and text lines found in the raster cache
+  METRIC_RASTER_MISSES,         // Icons and text lines not in the raster cache
+  METRIC_RASTER_EVICTIONS,      // Blocks evicted from the raster cache to make room
+  METRIC_RASTER_REFUSED,        // Blocks not cached because they were not seen recently
+  METRIC_RENDER_PREEMPTIONS,    // Drawing stopped part way for a higher priority command
+  METRIC_WIFI_DISCONNECTS,      // Lost the connection to the access point
+  METRIC_WIFI_RECONNECTS,       // Back on the network after losing it
+  METRIC_SENSOR_ERRORS,         // BME280 reads that failed
+  METRIC_COUNTER_COUNT
+} MetricCounter_t;
+
+// Position in the Prometheus text being written, for metrics_NextLine()
+typedef struct {
+  uint8_t section;          // Group of lines being written
+  uint16_t line;            // Next line within the group
+  uint32_t cumulative;      // Running bucket total of the current histogram
+  uint32_t sensorSamples;   // Sensor sample read when its group started
+  uint32_t sensorAgeMs;
+} MetricsCursor_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+// Number of finite histogram buckets (10us up to 250ms)
+#define METRICS_BUCKETS   14
+
+// Longest line of the Prometheus text, with its terminator
+#define METRICS_LINE_SIZE 128
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Read the CPU cycle counter to start timing an operation
+  * @param  none
+  * @retval Current cycle count
+  */
+uint32_t metrics_Start(void);
+
+/**
+  * @brief  Record how long an operation took in its histogram. Never
+  *         blocks or allocates, safe to call from any task.
+  * @param  which : Operation that was timed
+  * @param  startCycles : Value returned by metrics_Start() for this operation
+  * @param  startCore : Core the operation started on. Cycle counters are per
+  *                     core, so samples that moved cores are discarded.
+  * @retval none
+  */
+void metrics_Record(MetricTimer_t which, uint32_t startCycles, int startCore);
+
+/**
+  * @brief  Record an already measured duration in an operation's histogram.
+  *         Safe from any task or interrupt handler. The bucket is a
+  *         lock-free add; the 64-bit sum is updated by the toolchain's
+  *         atomics under a critical section of a few cycles.
+  * @param  which : Operation that was timed
+  * @param  us : How long it took in microseconds
+  * @retval none
+  */
+void metrics_RecordUs(MetricTimer_t which, uint32_t us);
+
+/**
+  * @brief  Add one to an event counter. Lock-free, safe from any task.
+  * @param  which : Counter to increment
+  * @retval none
+  */
+void metrics_Increment(MetricCounter_t which);
+
+/**
+  * @brief  Start writing every histogram and counter in Prometheus text
+  *         format, one line at a time, so the whole text never has to be
+  *         held in memory
+  * @param  cursor : filled in with the start of the text
+  * @retval none
+  */
+void metrics_Begin(MetricsCursor_t * cursor);
+
+/**
+  * @brief  Write the next line of the text started by metrics_Begin()
+  * @param  cursor : position in the text, moved past the line
+  * @param  line : where to write the line (zero terminated)
+  * @param  size : room in line, METRICS_LINE_SIZE is always enough
+  * @retval length of the line including its newline, 0 after the last one
+  */
+size_t metrics_NextLine(MetricsCursor_t * cursor, char * line, size_t size);
+
+/**
+  * @brief  Initialize the metrics module
+  * @param  none
+  * @retval none
+  */
+void metrics_Init(void);
+
+/**
+  * @brief  Times the enclosing scope into one histogram
+  *         Usage: { MetricsScope timer(METRIC_LCD_TEXT); ...work... }
+  */
+class MetricsScope
+{
+  public:
+    MetricsScope(MetricTimer_t which);
+    ~MetricsScope();
+
+  private:
+    MetricTimer_t which;
+    uint32_t startCycles;
+    int startCore;
+};
+
+#endif /* __METRICS_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
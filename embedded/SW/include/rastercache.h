@@ -0,0 +1,140 @@
+/**
+  ******************************************************************************
+  * @file    rastercache.h
+  * @author  Brian Schmalz
+  * @brief   Header file for the LRU cache of ready to draw pixel blocks
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RASTERCACHE_H__
+#define __RASTERCACHE_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// What a cached block was made from
+typedef enum {
+  RASTER_ICON = 0,              // Decoded icon, key is the icon name
+  RASTER_TEXT                   // Line of text, key is the text
+} RasterKind_t;
+
+// A block of RGB565 pixels (native byte order), ready to draw
+typedef struct {
+  uint16_t * pixels;
+  int16_t width;
+  int16_t height;
+} RasterBlock_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+// Bytes of pixels the cache may hold when the board has PSRAM. Set with
+// -DRASTERCACHE_BUDGET=... in platformio.ini build_flags. 0 turns the cache
+// off. A full width line of font 4 text is about 12 KB, so 64 KB holds a
+// full screen of lines and an icon, or the lines of two screens that take
+// turns (an alert and the weather it interrupted).
+#ifndef RASTERCACHE_BUDGET
+#define RASTERCACHE_BUDGET      65536
+#endif
+
+// Bytes the cache may hold without PSRAM, where it shares the internal heap
+// with the LCD frame, the sample history and the network stack. 24 KB is
+// enough for a repeated alert line and its icon.
+#ifndef RASTERCACHE_INTERNAL_BUDGET
+#define RASTERCACHE_INTERNAL_BUDGET 24576
+#endif
+
+// Most blocks held at once, and the longest key (including terminator)
+#define RASTERCACHE_ENTRIES     24
+#define RASTERCACHE_KEY_SIZE    64
+
+// Recent misses remembered so a block is only cached when it comes back
+#define RASTERCACHE_GHOSTS      16
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Pick the budget: RASTERCACHE_BUDGET in PSRAM if the board has
+  *         it, otherwise RASTERCACHE_INTERNAL_BUDGET of the normal heap.
+  *         Call once before the first rastercache_Insert().
+  * @param  none
+  * @retval none
+  */
+void rastercache_Init(void);
+
+/**
+  * @brief  Look up a block, marking it most recently used. Counts a hit or
+  *         a miss. The cache is not locked; only the render task uses it.
+  * @param  kind : What the block was made from
+  * @param  key : Icon name or text
+  * @param  color : Color the block was drawn in (0 for icons)
+  * @retval The block, or NULL if it is not cached
+  */
+const RasterBlock_t * rastercache_Find(RasterKind_t kind, const char * key, uint16_t color);
+
+/**
+  * @brief  Make room for a new block, evicting the least recently used ones
+  *         as needed. The caller fills in the pixels. A block is only cached
+  *         the second time it is inserted within the last RASTERCACHE_GHOSTS
+  *         refused inserts, so something drawn once (a new temperature)
+  *         never evicts or allocates.
+  * @param  kind : What the block is made from
+  * @param  key : Icon name or text
+  * @param  color : Color the block is drawn in (0 for icons)
+  * @param  width : Width of the block in pixels
+  * @param  height : Height of the block in pixels
+  * @retval The new block, or NULL if it isn't cached (not seen recently,
+  *         too big for the budget, key too long or out of memory)
+  */
+RasterBlock_t * rastercache_Insert(RasterKind_t kind, const char * key, uint16_t color,
+  int16_t width, int16_t height);
+
+/**
+  * @brief  Get the number of bytes of pixels currently cached
+  * @param  none
+  * @retval Bytes in use
+  */
+uint32_t rastercache_GetBytes(void);
+
+/**
+  * @brief  Get the number of bytes of pixels the cache may hold
+  * @param  none
+  * @retval Budget picked by rastercache_Init()
+  */
+uint32_t rastercache_GetBudget(void);
+
+#endif /* __RASTERCACHE_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -0,0 +1,138 @@
+/**
+  ******************************************************************************
+  * @file    render.h
+  * @author  Brian Schmalz
+  * @brief   Header file for display/LED render task
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RENDER_H__
+#define __RENDER_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+// Longest line of LCD text kept (including terminator)
+#define RENDER_TEXT_SIZE        64
+
+// Longest icon name kept (including terminator)
+#define RENDER_ICON_NAME_SIZE   16
+
+// Number of commands of each priority that can be waiting for the render task
+#define RENDER_QUEUE_DEPTH      4
+
+// Most icons kept on top of one priority's text
+#define RENDER_MAX_ICONS        4
+
+// Bits for RenderCommand_t.parts
+#define RENDER_PART_LCD         0x01
+#define RENDER_PART_LED         0x02
+#define RENDER_PART_ICON        0x04
+#define RENDER_PART_CLEAR       0x08    // Remove everything of this priority
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// Priority classes, lowest first. The highest class that has something to
+// show owns the screen and LEDs. Lower classes keep their content and get
+// the screen back when the higher class is cleared or its duration ends.
+typedef enum {
+  RENDER_PRIORITY_AMBIENT = 0,  // Weather, temperature, info
+  RENDER_PRIORITY_ADVISORY,
+  RENDER_PRIORITY_WATCH,
+  RENDER_PRIORITY_WARNING,
+  RENDER_PRIORITY_COUNT
+} RenderPriority_t;
+
+// Four lines of LCD text. Missing lines are empty strings.
+typedef struct {
+  char text[4][RENDER_TEXT_SIZE];
+} RenderLCD_t;
+
+// LED color and effect, same meaning as led_changeEffect() parameters.
+// A non-zero severity (AnimSeverity_t) uses that severity's preset instead.
+typedef struct {
+  uint8_t red;
+  uint8_t green;
+  uint8_t blue;
+  uint8_t effect;
+  uint32_t onTime;
+  uint32_t offTime;
+  uint8_t severity;
+  uint8_t fps;            // 0 = keep the current frame rate
+} RenderLED_t;
+
+// A named icon and where to draw it
+typedef struct {
+  char name[RENDER_ICON_NAME_SIZE];
+  int16_t x;
+  int16_t y;
+} RenderIcon_t;
+
+// One display/LED update. Only the parts flagged in 'parts' are used, and
+// they are applied together. New text clears the icons of that priority.
+typedef struct {
+  uint8_t parts;
+  uint8_t priority;       // RenderPriority_t
+  uint32_t durationMs;    // How long to keep it, 0 = until replaced or cleared
+  int64_t submittedUs;    // Set by render_Submit()
+  RenderLCD_t lcd;
+  RenderLED_t led;
+  RenderIcon_t icon;
+} RenderCommand_t;
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Queue a command for the render task. Never blocks. A command of
+  *         higher priority than what is being drawn stops that drawing at
+  *         the next step (text, icon or LED change) and is shown first.
+  * @param  command : Command to queue (copied)
+  * @retval true if queued, false if the queue for its priority is full and
+  *         the caller should ask the client to retry later
+  */
+bool render_Submit(const RenderCommand_t * command);
+
+/**
+  * @brief  Initialize the render module and start the render task.
+  *         Call after lcd_Init() and led_Init().
+  * @param  none
+  * @retval none
+  */
+void render_Init(void);
+
+#endif /* __RENDER_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -37,9 +37,19 @@
 #define __SENSOR_H__
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
 
 /* Exported types ------------------------------------------------------------*/ 
 
+// One consistent set of readings, all from the same sample
+typedef struct {
+  float temperature;      // deg C
+  float humidity;         // %RH
+  float pressure;         // mBar
+  uint32_t timestampMs;   // millis() when the sample was taken
+  uint32_t sequence;      // Counts up with every sample, 0 = no sample yet
+} SensorSnapshot_t;
+
 /* Exported constants --------------------------------------------------------*/
 
 /* Exported macros -----------------------------------------------------------*/
@@ -49,25 +59,13 @@
 /* Exported functions --------------------------------------------------------*/
 
 /**
-  * @brief  Return current temperature
-  * @param  none
-  * @retval Latest temperature reading as float
-  */
-float sensor_GetTemperature(void);
-
-/**
-  * @brief  Return current pressure
-  * @param  none
-  * @retval Latest pressure reading as float
-  */
-float sensor_GetPressure(void);
-
-/**
-  * @brief  Return current humidity
-  * @param  none
-  * @retval Latest humidity reading as float
+  * @brief  Copy the latest readings. Lock-free: never blocks the sensor task,
+  *         and retries if a new sample was being published during the copy,
+  *         so the readings always come from the same sample.
+  * @param  snapshot : filled in with the latest readings
+  * @retval none
   */
-float sensor_GetHumidity(void);
+void sensor_GetSnapshot(SensorSnapshot_t * snapshot);
 
 /**
   * @brief  Initialize sensor module.
@@ -1,7 +0,0 @@
-
-
-
-float sensor_GetTemperature(void);
-float sensor_GetPressure(void);
-float sensor_GetHumidity(void);
-void sensor_Init(void);
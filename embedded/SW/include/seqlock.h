@@ -0,0 +1,119 @@
+/**
+  ******************************************************************************
+  * @file    seqlock.h
+  * @author  Brian Schmalz
+  * @brief   Lock-free single writer snapshot (seqlock)
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SEQLOCK_H__
+#define __SEQLOCK_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <atomic>
+#include <type_traits>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Exported types ------------------------------------------------------------*/ 
+
+/// NOTE: Shares a small struct from one writer task with any number of
+/// readers. The writer makes the sequence odd, writes the words, then makes
+/// it even again. Readers copy the words and fail if the sequence was odd or
+/// changed meanwhile, so nobody ever waits on a lock and the writer is never
+/// held up. The words are relaxed atomics so the copy itself is never a data
+/// race. Only one task may call write().
+template <typename T>
+class SeqLock
+{
+  public:
+    SeqLock() : seq(0), words() {}
+
+    /**
+      * @brief  Publish a new value. Only ever call from one task.
+      * @param  value : value to publish
+      * @retval none
+      */
+    void write(const T & value)
+    {
+      uint32_t copy[WORDS];
+      uint32_t start = seq.load(std::memory_order_relaxed);
+
+      memcpy(copy, &value, sizeof(copy));
+
+      seq.store(start + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      for (size_t i = 0; i < WORDS; i++)
+      {
+        words[i].store(copy[i], std::memory_order_relaxed);
+      }
+      seq.store(start + 2, std::memory_order_release);
+    }
+
+    /**
+      * @brief  Try to copy the latest value
+      * @param  value : filled in only if the copy was consistent
+      * @retval false if a write was in progress, so try again
+      */
+    bool tryRead(T * value) const
+    {
+      uint32_t copy[WORDS];
+      uint32_t before = seq.load(std::memory_order_acquire);
+
+      if (before & 1)
+      {
+        return false;
+      }
+      for (size_t i = 0; i < WORDS; i++)
+      {
+        copy[i] = words[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq.load(std::memory_order_relaxed) != before)
+      {
+        return false;
+      }
+      memcpy(value, copy, sizeof(copy));
+      return true;
+    }
+
+  private:
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "value must be whole words");
+    static_assert(std::is_trivially_copyable<T>::value, "value must be plain data");
+    static const size_t WORDS = sizeof(T) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> seq;
+    std::atomic<uint32_t> words[WORDS];
+};
+
+#endif /* __SEQLOCK_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -0,0 +1,164 @@
+/**
+  ******************************************************************************
+  * @file    taskstats.h
+  * @author  Brian Schmalz
+  * @brief   Header file for per-task CPU, stack and heap statistics
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TASKSTATS_H__
+#define __TASKSTATS_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <FreeRTOS.h>
+#include <freertos/task.h>
+
+/* Exported constants --------------------------------------------------------*/
+
+// Most tasks reported (every task in the system, not only ours)
+#ifndef TASKSTATS_MAX_TASKS
+#define TASKSTATS_MAX_TASKS     32
+#endif
+
+// Time between run time samples, and how many are kept: enough for the
+// longest window plus the sample it is measured from
+#define TASKSTATS_PERIOD_MS     5000
+#define TASKSTATS_HISTORY       13
+
+// CPU share is reported over these windows (5 s and 60 s)
+#define TASKSTATS_WINDOW_COUNT  2
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// Run time of every task at one moment
+typedef struct {
+  UBaseType_t number[TASKSTATS_MAX_TASKS];  // xTaskNumber, never reused
+  uint32_t runTime[TASKSTATS_MAX_TASKS];
+  uint32_t totalRunTime;
+  int64_t timeUs;                           // esp_timer_get_time() when taken
+  uint8_t count;
+} TaskSnapshot_t;
+
+// A read of every task, made by taskstats_Begin()
+typedef struct {
+  TaskStatus_t tasks[TASKSTATS_MAX_TASKS];
+  int8_t core[TASKSTATS_MAX_TASKS];
+  uint32_t totalRunTime;
+  int64_t timeUs;
+  uint16_t count;
+  uint16_t next;
+  TaskSnapshot_t base[TASKSTATS_WINDOW_COUNT];  // Start of each window (empty = boot)
+} TaskStatsQuery_t;
+
+// One task
+typedef struct {
+  const char * name;
+  const char * state;           // "running", "ready", "blocked", "suspended", "deleted"
+  UBaseType_t priority;
+  int core;                     // -1 if not pinned (or not in the build)
+  uint32_t stackFree;           // Stack never used so far (bytes)
+  float cpu[TASKSTATS_WINDOW_COUNT];  // % of one core over each window, negative if unknown
+} TaskStatsRow_t;
+
+// Internal RAM (PSRAM is left out, it is only used for sample history)
+typedef struct {
+  uint32_t free;
+  uint32_t minFree;             // Lowest free since boot
+  uint32_t largestBlock;        // Biggest single allocation that would succeed
+  float fragmentation;          // 1 - largestBlock / free
+} TaskHeapStats_t;
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Initialize the task statistics
+  * @param  none
+  * @retval none
+  */
+void taskstats_Init(void);
+
+/**
+  * @brief  Take a run time sample if TASKSTATS_PERIOD_MS has passed since
+  *         the last one. Call often (i.e. from loop()); a sample is one
+  *         uxTaskGetSystemState() call, so it is cheap enough to leave on.
+  * @param  none
+  * @retval none
+  */
+void taskstats_Sample(void);
+
+/**
+  * @brief  Read every task now, for taskstats_Next()
+  * @param  query : filled in with the read
+  * @retval true on success, false if there are more than
+  *         TASKSTATS_MAX_TASKS tasks
+  */
+bool taskstats_Begin(TaskStatsQuery_t * query);
+
+/**
+  * @brief  Get the next task of a read
+  * @param  query : read started with taskstats_Begin()
+  * @param  row : filled in with the task (name points into query)
+  * @retval true if a task was returned, false after the last one
+  */
+bool taskstats_Next(TaskStatsQuery_t * query, TaskStatsRow_t * row);
+
+/**
+  * @brief  Actual length of a window of a read. Windows are measured from
+  *         the newest sample at least the window's length old, so they
+  *         run up to one TASKSTATS_PERIOD_MS longer, and until there is
+  *         such a sample they go back to boot.
+  * @param  query : read started with taskstats_Begin()
+  * @param  window : window number
+  * @retval length in milliseconds
+  */
+uint32_t taskstats_GetWindowMs(const TaskStatsQuery_t * query, int window);
+
+/**
+  * @brief  Name of a window ("5s", "60s")
+  * @param  window : window number
+  * @retval window name
+  */
+const char * taskstats_GetWindowName(int window);
+
+/**
+  * @brief  Get the heap statistics
+  * @param  heap : filled in with the statistics
+  * @retval none
+  */
+void taskstats_GetHeap(TaskHeapStats_t * heap);
+
+#endif /* __TASKSTATS_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
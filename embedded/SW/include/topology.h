@@ -0,0 +1,108 @@
+/**
+  ******************************************************************************
+  * @file    topology.h
+  * @author  Brian Schmalz
+  * @brief   Header file for task placement, priorities and stack budgets
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TOPOLOGY_H__
+#define __TOPOLOGY_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <FreeRTOS.h>
+#include <freertos/task.h>
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// Every task this firmware creates. Their names, stack sizes, priorities
+// and cores are all in the table in topology.cpp.
+typedef enum {
+  TASK_LOG_DRAIN = 0,
+  TASK_SENSOR,
+  TASK_WIFI,
+  TASK_RENDER,
+  TASK_LED,
+  TASK_BOOT_LCD,
+  TASK_BOOT_LED,
+  TASK_BOOT_SENSOR,
+  TASK_ID_COUNT
+} TaskId_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+// Core 0 also runs the WiFi driver, lwIP and AsyncTCP, so network work
+// goes there. Core 1 is kept for LCD drawing and LED frame timing.
+#define TOPOLOGY_NETWORK_CORE   0
+#define TOPOLOGY_RENDER_CORE    1
+
+// A task with less stack than this left unused is reported
+#ifndef TOPOLOGY_STACK_MARGIN
+#define TOPOLOGY_STACK_MARGIN   512
+#endif
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Create one of the firmware's tasks, pinned to its core with the
+  *         stack size and priority from the table
+  * @param  id : which task
+  * @param  function : task function
+  * @param  parameter : parameter to pass to the task function
+  * @param  handle : filled in with the task handle (can be NULL)
+  * @retval true if the task was created
+  */
+bool topology_Create(TaskId_t id, TaskFunction_t function, void * parameter, TaskHandle_t * handle);
+
+/**
+  * @brief  End the calling task. Use instead of vTaskDelete(NULL) for a
+  *         task started with topology_Create(), so it is no longer checked.
+  * @param  id : which task is ending
+  * @retval none
+  */
+void topology_Exit(TaskId_t id);
+
+/**
+  * @brief  Check how much stack each running task has never used, and warn
+  *         (once per task) about any with less than TOPOLOGY_STACK_MARGIN
+  *         bytes left. Cheap enough to call every second.
+  * @param  none
+  * @retval none
+  */
+void topology_CheckStacks(void);
+
+#endif /* __TOPOLOGY_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
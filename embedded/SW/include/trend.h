@@ -0,0 +1,135 @@
+/**
+  ******************************************************************************
+  * @file    trend.h
+  * @author  Brian Schmalz
+  * @brief   Rolling sensor statistics and local alert rules
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TREND_H__
+#define __TREND_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "tscodec.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// Longest statistics window in minutes
+#define TREND_MAX_WINDOW        360
+
+// Most alert rules
+#define TREND_MAX_RULES         8
+
+/* Exported types ------------------------------------------------------------*/ 
+
+typedef enum {
+  TREND_TEMPERATURE = 0,        // deg C
+  TREND_HUMIDITY,               // %RH
+  TREND_PRESSURE,               // mBar
+  TREND_CHANNELS
+} TrendChannel_t;
+
+typedef enum {
+  TREND_WINDOW_1H = 0,
+  TREND_WINDOW_3H,
+  TREND_WINDOW_6H,
+  TREND_WINDOW_COUNT
+} TrendWindow_t;
+
+// Statistics of one channel over one window, including the current minute
+typedef struct {
+  float min;
+  float max;
+  float mean;
+  float slope;                  // Least squares slope of the minute means, per hour
+  uint16_t minutes;             // Minutes with samples in the window (slope needs 2)
+} TrendWindowStats_t;
+
+typedef struct {
+  float ewma;                   // Exponentially weighted moving average of every sample
+  TrendWindowStats_t window[TREND_WINDOW_COUNT];
+} TrendChannelStats_t;
+
+// Everything computed as of the latest sample
+typedef struct {
+  TrendChannelStats_t channel[TREND_CHANNELS];
+  uint32_t samples;             // Samples since the statistics were last reset
+  uint32_t activeRules;         // Bit n set while rule n is raised
+} TrendStats_t;
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Set up the statistics
+  * @param  periodMs : time between samples (for the EWMA time constant)
+  * @retval none
+  */
+void trend_Init(uint32_t periodMs);
+
+/**
+  * @brief  Add one sample, update the statistics and check the alert rules.
+  *         Constant time per sample: samples are folded into minute buckets,
+  *         and each window keeps running sums for its mean and slope and
+  *         monotonic queues for its min and max. A rule that becomes true
+  *         raises its LED/LCD alert right away. Only the sensor task calls this.
+  * @param  sample : the new sample
+  * @retval none
+  */
+void trend_Add(const TsSample_t * sample);
+
+/**
+  * @brief  Copy the statistics as of the latest sample
+  * @param  stats : filled in with the statistics
+  * @retval none
+  */
+void trend_GetStats(TrendStats_t * stats);
+
+/**
+  * @brief  Name of an alert rule, for reporting which rules are raised
+  * @param  rule : rule number (bit number in TrendStats_t.activeRules)
+  * @retval rule name, or NULL if there is no such rule
+  */
+const char * trend_GetRuleName(uint8_t rule);
+
+/**
+  * @brief  Name of a statistics window ("1h", "3h", "6h")
+  * @param  window : the window
+  * @retval window name
+  */
+const char * trend_GetWindowName(TrendWindow_t window);
+
+#endif /* __TREND_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
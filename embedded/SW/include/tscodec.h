@@ -0,0 +1,121 @@
+/**
+  ******************************************************************************
+  * @file    tscodec.h
+  * @author  Brian Schmalz
+  * @brief   Gorilla style time series block codec
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TSCODEC_H__
+#define __TSCODEC_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// One sensor sample in fixed point
+typedef struct {
+  int64_t timeMs;               // Unix time in ms (time since boot until the clock is set)
+  int32_t temperature;          // 0.01 deg C
+  int32_t humidity;             // 0.01 %RH
+  int32_t pressure;             // 0.001 mBar
+} TsSample_t;
+
+// Packs samples into a bit stream. Set up with tscodec_BeginEncode().
+typedef struct {
+  uint8_t * data;
+  uint32_t capacity;            // Size of data in bits
+  uint32_t bits;                // Bits written so far
+  uint16_t count;               // Samples written so far
+  TsSample_t last;              // Previous sample
+  int64_t lastDeltaMs;          // Time between the previous two samples
+} TsEncoder_t;
+
+// Unpacks a bit stream written by a TsEncoder_t
+typedef struct {
+  const uint8_t * data;
+  uint32_t bits;                // Bits in the stream
+  uint32_t pos;                 // Next bit to read
+  uint16_t remaining;           // Samples still to read
+  bool first;                   // Next sample is the first
+  TsSample_t last;
+  int64_t lastDeltaMs;
+} TsDecoder_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Start a new stream. The first sample is stored in full, then
+  *         times as delta of delta and values as deltas, each in a prefix
+  *         coded field as short as the value allows (a steady clock and an
+  *         unchanged value take one bit each).
+  * @param  encoder : encoder to set up
+  * @param  data : buffer for the stream
+  * @param  size : bytes in data
+  * @retval none
+  */
+void tscodec_BeginEncode(TsEncoder_t * encoder, uint8_t * data, uint32_t size);
+
+/**
+  * @brief  Append one sample
+  * @param  encoder : encoder to append to
+  * @param  sample : sample to append
+  * @retval false (and the stream unchanged) if the sample does not fit
+  */
+bool tscodec_Encode(TsEncoder_t * encoder, const TsSample_t * sample);
+
+/**
+  * @brief  Start reading a stream
+  * @param  decoder : decoder to set up
+  * @param  data : the stream
+  * @param  bits : bits in the stream
+  * @param  count : samples in the stream
+  * @retval none
+  */
+void tscodec_BeginDecode(TsDecoder_t * decoder, const uint8_t * data, uint32_t bits, uint16_t count);
+
+/**
+  * @brief  Read the next sample
+  * @param  decoder : decoder to read from
+  * @param  sample : filled in with the sample
+  * @retval false at the end of the stream, or if it is corrupt
+  */
+bool tscodec_Decode(TsDecoder_t * decoder, TsSample_t * sample);
+
+#endif /* __TSCODEC_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -0,0 +1,124 @@
+/**
+  ******************************************************************************
+  * @file    tslog.h
+  * @author  Brian Schmalz
+  * @brief   Persistent compressed sample log on LittleFS
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TSLOG_H__
+#define __TSLOG_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "tscodec.h"
+
+/* Exported constants --------------------------------------------------------*/
+
+// Bytes per block. Every block is written whole, carries its own CRC and
+// starts with a full sample, so it can be checked and decoded on its own.
+#define TSLOG_BLOCK_SIZE        512
+
+// Blocks per segment file. When a segment is full the next one is started.
+#define TSLOG_SEGMENT_BLOCKS    64
+
+// Segments kept; the oldest is deleted to make room for a new one. Set with
+// -DTSLOG_MAX_SEGMENTS=... in platformio.ini build_flags. The default caps
+// the log at 1 MB, about 2.5 days at 1 Hz.
+#ifndef TSLOG_MAX_SEGMENTS
+#define TSLOG_MAX_SEGMENTS      32
+#endif
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// State of one range read. Filled in by tslog_BeginRead().
+typedef struct {
+  int64_t fromMs;
+  int64_t toMs;
+  uint32_t segment;             // Number of the segment being read
+  uint16_t block;               // Next block to read in that segment
+  bool located;                 // block has been found by searching for fromMs
+  bool loaded;                  // data holds a block being decoded
+  bool done;                    // Passed toMs
+  uint8_t data[TSLOG_BLOCK_SIZE];
+  TsDecoder_t decoder;
+} TslogCursor_t;
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Mount LittleFS (formatting it if needed) and index the segments
+  *         already on flash
+  * @retval true if the log can be used
+  */
+bool tslog_Init(void);
+
+/**
+  * @brief  Append one sample. Samples are packed into a block in RAM and
+  *         the block is written when full. Samples taken before the clock
+  *         has been set are not logged, as their times mean nothing after
+  *         a reboot. Only the sensor task calls this.
+  * @param  sample : sample to append
+  * @retval none
+  */
+void tslog_Add(const TsSample_t * sample);
+
+/**
+  * @brief  Start reading the logged samples from fromMs to toMs (inclusive)
+  * @param  cursor : cursor to set up
+  * @param  fromMs : start of the range
+  * @param  toMs : end of the range
+  * @retval none
+  */
+void tslog_BeginRead(TslogCursor_t * cursor, int64_t fromMs, int64_t toMs);
+
+/**
+  * @brief  Get the next logged sample in the range, oldest first. Finds the
+  *         first block with a binary search on the block headers.
+  * @param  cursor : cursor started with tslog_BeginRead()
+  * @param  sample : filled in with the sample
+  * @retval false once the range is done
+  */
+bool tslog_Next(TslogCursor_t * cursor, TsSample_t * sample);
+
+/**
+  * @brief  Time of the oldest logged sample
+  * @param  timeMs : filled in with the time
+  * @retval false if the log is empty
+  */
+bool tslog_GetOldest(int64_t * timeMs);
+
+#endif /* __TSLOG_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -0,0 +1,87 @@
+/**
+  ******************************************************************************
+  * @file    wifimgr.h
+  * @author  Brian Schmalz
+  * @brief   Header file for the background WiFi manager
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __WIFIMGR_H__
+#define __WIFIMGR_H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/ 
+
+// Connection history since boot
+typedef struct {
+  bool connected;               // On the network (have an address) now
+  uint32_t disconnects;         // Times the connection was lost
+  uint32_t reconnects;          // Times it came back
+  uint32_t fastConnects;        // Connects that used the cached BSSID and channel
+  uint32_t attempts;            // Connect attempts, including failed ones
+  uint32_t lastReconnectMs;     // From losing the connection to having an address again
+  uint32_t maxReconnectMs;
+  uint32_t totalReconnectMs;    // Sum over all reconnects, for the mean
+  uint8_t lastReason;           // wifi_err_reason_t of the last disconnect
+} WifiStats_t;
+
+/* Exported constants --------------------------------------------------------*/
+
+/* Exported macros -----------------------------------------------------------*/
+
+/* Exported variables --------------------------------------------------------*/
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Start the WiFi manager task. It connects in the background, first
+  *         straight to the access point and channel it last used (kept in
+  *         NVS), and reconnects with jittered exponential backoff whenever
+  *         the connection is lost. Returns straight away.
+  * @param  ssid : access point to connect to (must stay valid)
+  * @param  password : its password (must stay valid)
+  * @param  onConnected : called from the manager task each time we get an
+  *         address, the first time and after every reconnect
+  * @retval none
+  */
+void wifimgr_Init(const char * ssid, const char * password, void (*onConnected)(void));
+
+/**
+  * @brief  Copy the connection history
+  * @param  stats : filled in with the history
+  * @retval none
+  */
+void wifimgr_GetStats(WifiStats_t * stats);
+
+#endif /* __WIFIMGR_H__ */
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -0,0 +1,470 @@
+"""
+Converts the weather icons in client/images into the Puck's icon store.
+
+Each icon is decoded (palette or RGBA PNG, plain Python, no PIL needed),
+scaled down to the size shown on the Puck's display, converted to RGB565
+and run length encoded. Two files are generated:
+
+    src/icondata.cpp     All encoded icons back to back in one const array
+    include/icontable.h  constexpr descriptors (offset, size, dimensions,
+                         encoding) and a perfect hash table from icon name
+                         to descriptor, so a lookup is one hash and one
+                         string compare, all from flash
+
+PlatformIO runs this before every build (see icons_prebuild.py) and it
+only regenerates when an image or this script changed, so adding an icon
+is just dropping its PNG into client/images.
+
+Encoding, one row at a time (runs never cross rows), little endian colors:
+    00nnnnnn                  n + 1 transparent pixels
+    01nnnnnn  color           n + 1 pixels of one color
+    10nnnnnn  color * (n + 1) n + 1 pixels, each with its own color
+The color ICON_TRANSPARENT (magenta, 0xF81F) is never used by an opaque
+pixel, so the decoder can hand rows to TFT_eSPI's pushImage() with it as
+the transparent color.
+
+Run `python icon_convert.py [image dir] [size]` to regenerate by hand.
+"""
+
+import glob
+import os
+import re
+import struct
+import sys
+import zlib
+
+TRANSPARENT = 0xF81F
+RUN_TRANSPARENT = 0x00
+RUN_REPEAT = 0x40
+RUN_LITERAL = 0x80
+MAX_RUN = 64
+
+# Weather codes used by the client (a01d, c02n, ...)
+ICON_NAME = re.compile(r'^[a-z]\d\d[dn]$')
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_SOURCE = os.path.join(HERE, '..', '..', '..', 'client', 'images')
+PROJECT = os.path.join(HERE, '..')
+DATA_FILE = os.path.join('src', 'icondata.cpp')
+TABLE_FILE = os.path.join('include', 'icontable.h')
+DEFAULT_SIZE = 64
+
+# FNV-1a prime. The perfect hash is FNV-1a with a searched offset basis.
+FNV_PRIME = 16777619
+
+
+def read_png(path):
+    """Returns (width, height, rows) with rows of (r, g, b, a) tuples.
+
+    Handles the 8 bit, non interlaced palette and RGB(A) images the client
+    uses.
+    """
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('%s is not a PNG file' % path)
+
+    pos = 8
+    idat = b''
+    palette = []
+    alpha = []
+    while pos < len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b'IHDR':
+            width, height, depth, color, _, _, interlace = struct.unpack('>IIBBBBB', body)
+        elif kind == b'PLTE':
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b'tRNS':
+            alpha = list(body)
+        elif kind == b'IDAT':
+            idat += body
+        elif kind == b'IEND':
+            break
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    if depth != 8 or interlace != 0:
+        raise ValueError('%s: only 8 bit non interlaced PNGs are supported' % path)
+
+    raw = zlib.decompress(idat)
+    stride = width * channels
+    rows = []
+    previous = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        kind = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        unfilter(kind, line, previous, channels)
+        previous = line
+
+        pixels = []
+        for x in range(width):
+            px = line[x * channels:(x + 1) * channels]
+            if color == 3:
+                index = px[0]
+                r, g, b = palette[index]
+                a = alpha[index] if index < len(alpha) else 255
+            elif color == 6:
+                r, g, b, a = px
+            elif color == 2:
+                r, g, b = px
+                a = 255
+            elif color == 4:
+                r = g = b = px[0]
+                a = px[1]
+            else:
+                r = g = b = px[0]
+                a = 255
+            pixels.append((r, g, b, a))
+        rows.append(pixels)
+    return width, height, rows
+
+
+def unfilter(kind, line, previous, bpp):
+    """Undoes the PNG filter of one scanline in place."""
+    for i in range(len(line)):
+        left = line[i - bpp] if i >= bpp else 0
+        up = previous[i]
+        upleft = previous[i - bpp] if i >= bpp else 0
+        if kind == 1:
+            line[i] = (line[i] + left) & 0xFF
+        elif kind == 2:
+            line[i] = (line[i] + up) & 0xFF
+        elif kind == 3:
+            line[i] = (line[i] + ((left + up) >> 1)) & 0xFF
+        elif kind == 4:
+            p = left + up - upleft
+            pa, pb, pc = abs(p - left), abs(p - up), abs(p - upleft)
+            if pa <= pb and pa <= pc:
+                predictor = left
+            elif pb <= pc:
+                predictor = up
+            else:
+                predictor = upleft
+            line[i] = (line[i] + predictor) & 0xFF
+
+
+def scale(width, height, rows, size):
+    """Box filters the image down (or up) to size x size.
+
+    Returns rows of RGB565 values, None for transparent pixels. A pixel is
+    opaque if at least half of the area it covers is; its color is the
+    alpha weighted average of what it covers.
+    """
+    out = []
+    for oy in range(size):
+        y0, y1 = oy * height / size, (oy + 1) * height / size
+        line = []
+        for ox in range(size):
+            x0, x1 = ox * width / size, (ox + 1) * width / size
+            total = weight = r = g = b = 0.0
+            y = int(y0)
+            while y < y1:
+                wy = min(y + 1, y1) - max(y, y0)
+                x = int(x0)
+                while x < x1:
+                    wx = min(x + 1, x1) - max(x, x0)
+                    pr, pg, pb, pa = rows[y][x]
+                    area = wx * wy
+                    total += area
+                    w = area * pa / 255.0
+                    weight += w
+                    r += pr * w
+                    g += pg * w
+                    b += pb * w
+                    x += 1
+                y += 1
+            if weight < total / 2:
+                line.append(None)
+                continue
+            r, g, b = int(r / weight + 0.5), int(g / weight + 0.5), int(b / weight + 0.5)
+            value = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+            if value == TRANSPARENT:
+                value -= 1
+            line.append(value)
+        out.append(line)
+    return out
+
+
+def encode_row(pixels):
+    """Run length encodes one row of RGB565 / None pixels."""
+    out = bytearray()
+    i = 0
+    n = len(pixels)
+
+    def repeat_length(start):
+        end = start
+        while end < n and end - start < MAX_RUN and pixels[end] == pixels[start]:
+            end += 1
+        return end - start
+
+    while i < n:
+        if pixels[i] is None:
+            count = repeat_length(i)
+            out.append(RUN_TRANSPARENT | (count - 1))
+            i += count
+            continue
+
+        count = repeat_length(i)
+        if count >= 2:
+            out.append(RUN_REPEAT | (count - 1))
+            out += struct.pack('<H', pixels[i])
+            i += count
+            continue
+
+        # Literal run, until a transparent pixel or a run of 3 or more
+        start = i
+        while i < n and i - start < MAX_RUN and pixels[i] is not None:
+            if i > start and repeat_length(i) >= 3:
+                break
+            i += 1
+        out.append(RUN_LITERAL | (i - start - 1))
+        for value in pixels[start:i]:
+            out += struct.pack('<H', value)
+    return bytes(out)
+
+
+def decode(data, width, height):
+    """Reference decoder, used to check every encoded icon."""
+    rows = []
+    pos = 0
+    for _ in range(height):
+        line = []
+        while len(line) < width:
+            op = data[pos]
+            pos += 1
+            count = (op & 0x3F) + 1
+            if op & 0xC0 == RUN_TRANSPARENT:
+                line += [None] * count
+            elif op & 0xC0 == RUN_REPEAT:
+                line += [struct.unpack('<H', data[pos:pos + 2])[0]] * count
+                pos += 2
+            else:
+                line += list(struct.unpack('<%dH' % count, data[pos:pos + 2 * count]))
+                pos += 2 * count
+        rows.append(line)
+    return rows
+
+
+def convert(source, size):
+    """Returns a sorted list of (name, size, encoded bytes) for the icons."""
+    icons = []
+    for path in sorted(glob.glob(os.path.join(source, '*.png'))):
+        name = os.path.splitext(os.path.basename(path))[0]
+        if not ICON_NAME.match(name):
+            continue
+        width, height, rows = read_png(path)
+        pixels = scale(width, height, rows, size)
+        data = b''.join(encode_row(row) for row in pixels)
+        if decode(data, size, size) != pixels:
+            raise ValueError('%s: encoding does not round trip' % path)
+        icons.append((name, size, data))
+    return icons
+
+
+def icon_hash(name, seed):
+    """Same hash as icontable_Hash() in the generated header."""
+    value = seed
+    for c in name.encode('ascii'):
+        value = ((value ^ c) * FNV_PRIME) & 0xFFFFFFFF
+    return value ^ (value >> 16)
+
+
+def perfect_hash(names):
+    """Finds a seed and a power of two table size with no collisions.
+
+    Returns (seed, slots) where slots[i] is the index of the name that hashes
+    to slot i, or -1.
+    """
+    size = 1
+    while size < 2 * len(names):
+        size *= 2
+    while True:
+        for seed in range(1, 200000):
+            slots = [-1] * size
+            for index, name in enumerate(names):
+                slot = icon_hash(name, seed) & (size - 1)
+                if slots[slot] >= 0:
+                    break
+                slots[slot] = index
+            else:
+                return seed, slots
+        size *= 2
+
+
+def write_if_changed(path, text):
+    """Writes a file unless it already holds exactly this text, so an
+    unchanged file does not trigger a rebuild."""
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                return
+    with open(path, 'w') as f:
+        f.write(text)
+
+
+def layout(icons):
+    """Places the encoded icons back to back. Icons with identical data
+    (some day and night icons are the same) share one copy.
+
+    Returns (blobs, offsets): the (names, data) to store in order, and the
+    offset of each icon's data.
+    """
+    blobs = []
+    offsets = []
+    placed = {}
+    end = 0
+    for name, _, data in icons:
+        if data not in placed:
+            placed[data] = (end, len(blobs))
+            blobs.append(([], data))
+            end += len(data)
+        offset, blob = placed[data]
+        blobs[blob][0].append(name)
+        offsets.append(offset)
+    return blobs, offsets
+
+
+def write_data(blobs, size, path):
+    """Writes the encoded icons back to back as one C++ array."""
+    lines = [
+        '/*',
+        ' * Generated by scripts/icon_convert.py from client/images. Do not edit.',
+        ' */',
+        '',
+        '#include <stdint.h>',
+        '',
+        '// Declared in icons.cpp. Declared extern here too so the const',
+        '// definition below is visible outside this file.',
+        'extern const uint8_t IconData[];',
+        '',
+        'const uint8_t IconData[] = {',
+    ]
+    for names, data in blobs:
+        lines.append('  // %s: %dx%d, %d bytes (%d uncompressed)'
+                     % (', '.join(names), size, size, len(data), size * size * 2))
+        for i in range(0, len(data), 16):
+            lines.append('  ' + ', '.join('0x%02X' % b for b in data[i:i + 16]) + ',')
+    lines.append('};')
+    lines.append('')
+    write_if_changed(path, '\n'.join(lines))
+
+
+LOOKUP_FUNCTIONS = r'''
+// FNV-1a over the name, starting from ICONTABLE_SEED, then folded
+constexpr uint32_t icontable_Hash(const char * name, uint32_t hash = ICONTABLE_SEED)
+{
+  return (*name == '\0') ? (hash ^ (hash >> 16))
+    : icontable_Hash(name + 1, (hash ^ (uint8_t)*name) * 16777619u);
+}
+
+constexpr bool icontable_Equal(const char * a, const char * b)
+{
+  return (*a == *b) && (*a == '\0' || icontable_Equal(a + 1, b + 1));
+}
+
+constexpr int icontable_Check(const char * name, int index)
+{
+  return (index >= 0 && icontable_Equal(IconAssets[index].name, name)) ? index : -1;
+}
+
+// Index of the named icon in IconAssets, or -1 if there is no such icon
+constexpr int icontable_Find(const char * name)
+{
+  return icontable_Check(name, IconSlots[icontable_Hash(name) & (ICONTABLE_SLOTS - 1)]);
+}
+'''
+
+
+def write_table(icons, offsets, path):
+    """Writes the constexpr descriptor and perfect hash tables."""
+    names = [name for name, _, _ in icons]
+    seed, slots = perfect_hash(names)
+
+    lines = [
+        '/*',
+        ' * Generated by scripts/icon_convert.py from client/images. Do not edit.',
+        ' *',
+        ' * Icon descriptors and a perfect hash table from icon name to',
+        ' * descriptor. Everything is constexpr, so the tables live in flash',
+        ' * and lookups of constant names are done by the compiler.',
+        ' */',
+        '',
+        '#ifndef __ICONTABLE_H__',
+        '#define __ICONTABLE_H__',
+        '',
+        '#include <stdint.h>',
+        '#include "icons.h"',
+        '',
+        '#define ICONTABLE_COUNT   %d' % len(icons),
+        '#define ICONTABLE_SLOTS   %d' % len(slots),
+        '#define ICONTABLE_SEED    0x%08Xu' % seed,
+        '',
+        '// Offsets are into IconData (icondata.cpp)',
+        'constexpr IconAsset_t IconAssets[ICONTABLE_COUNT] = {',
+    ]
+    for (name, size, data), offset in zip(icons, offsets):
+        lines.append('  { "%s", %d, %d, ICON_ENCODING_RLE, %d, %d },'
+                     % (name, size, size, offset, len(data)))
+    lines.append('};')
+    lines.append('')
+    lines.append('// Index into IconAssets for each hash slot, -1 if empty')
+    lines.append('constexpr int8_t IconSlots[ICONTABLE_SLOTS] = {')
+    for i in range(0, len(slots), 16):
+        lines.append('  ' + ', '.join('%d' % v for v in slots[i:i + 16]) + ',')
+    lines.append('};')
+    lines.append(LOOKUP_FUNCTIONS)
+    lines.append('// Every icon must be found at its own index')
+    for index, name in enumerate(names):
+        lines.append('static_assert(icontable_Find("%s") == %d, "icon hash table is broken");'
+                     % (name, index))
+    lines.append('')
+    lines.append('#endif /* __ICONTABLE_H__ */')
+    lines.append('')
+    write_if_changed(path, '\n'.join(lines))
+
+
+def out_of_date(source, project):
+    """True if any image or this script is newer than the generated files."""
+    outputs = [os.path.join(project, DATA_FILE), os.path.join(project, TABLE_FILE)]
+    if not all(os.path.exists(path) for path in outputs):
+        return True
+    built = min(os.path.getmtime(path) for path in outputs)
+    inputs = glob.glob(os.path.join(source, '*.png')) + [source, os.path.abspath(__file__)]
+    return any(os.path.getmtime(path) > built for path in inputs)
+
+
+def generate(source=DEFAULT_SOURCE, project=PROJECT, size=DEFAULT_SIZE, force=False):
+    """Regenerates the icon store if needed. Returns a one line summary."""
+    if not force and not out_of_date(source, project):
+        return 'icons up to date'
+
+    icons = convert(source, size)
+    if len(icons) > 127:
+        raise ValueError('too many icons for the int8_t hash slots')
+    data_path = os.path.join(project, DATA_FILE)
+    table_path = os.path.join(project, TABLE_FILE)
+    blobs, offsets = layout(icons)
+    write_data(blobs, size, data_path)
+    write_table(icons, offsets, table_path)
+
+    # Mark the outputs as up to date even if their contents did not change
+    # (and so were not rewritten)
+    for path in (data_path, table_path):
+        os.utime(path, None)
+
+    total = sum(len(data) for _, data in blobs)
+    return '%d icons, %d bytes encoded (%d uncompressed)' % (
+        len(icons), total, len(icons) * size * size * 2)
+
+
+def main():
+    source = sys.argv[1] if len(sys.argv) > 1 else DEFAULT_SOURCE
+    size = int(sys.argv[2]) if len(sys.argv) > 2 else DEFAULT_SIZE
+    print(generate(source, PROJECT, size, force=True))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,15 @@
+"""
+PlatformIO pre-build step that keeps the generated icon store
+(src/icondata.cpp and include/icontable.h) in step with client/images.
+Hooked in through extra_scripts in platformio.ini.
+"""
+
+import os
+import sys
+
+Import('env')
+
+sys.path.insert(0, os.path.join(env.subst('$PROJECT_DIR'), 'scripts'))
+import icon_convert
+
+print('Icons: ' + icon_convert.generate(project=env.subst('$PROJECT_DIR')))
@@ -0,0 +1,368 @@
+/**
+  ******************************************************************************
+  * @file    anim.cpp
+  * @author  Brian Schmalz
+  * @brief   Keyframe LED animation engine
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "anim.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+// Length of the chase tail in pixels
+#define ANIM_CHASE_TAIL     4
+
+// Rotation time used when a swirl or chase doesn't give one
+#define ANIM_DEFAULT_ROTATION_MS  1000
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+// One full sine wave over 256 steps, scaled to 1-255 (128 = zero crossing)
+const uint8_t SineTable[256] = {
+  128, 131, 134, 137, 140, 144, 147, 150, 153, 156, 159, 162, 165, 168, 171, 174,
+  177, 179, 182, 185, 188, 191, 193, 196, 199, 201, 204, 206, 209, 211, 213, 216,
+  218, 220, 222, 224, 226, 228, 230, 232, 234, 235, 237, 239, 240, 241, 243, 244,
+  245, 246, 248, 249, 250, 250, 251, 252, 253, 253, 254, 254, 254, 255, 255, 255,
+  255, 255, 255, 255, 254, 254, 254, 253, 253, 252, 251, 250, 250, 249, 248, 246,
+  245, 244, 243, 241, 240, 239, 237, 235, 234, 232, 230, 228, 226, 224, 222, 220,
+  218, 216, 213, 211, 209, 206, 204, 201, 199, 196, 193, 191, 188, 185, 182, 179,
+  177, 174, 171, 168, 165, 162, 159, 156, 153, 150, 147, 144, 140, 137, 134, 131,
+  128, 125, 122, 119, 116, 112, 109, 106, 103, 100,  97,  94,  91,  88,  85,  82,
+   79,  77,  74,  71,  68,  65,  63,  60,  57,  55,  52,  50,  47,  45,  43,  40,
+   38,  36,  34,  32,  30,  28,  26,  24,  22,  21,  19,  17,  16,  15,  13,  12,
+   11,  10,   8,   7,   6,   6,   5,   4,   3,   3,   2,   2,   2,   1,   1,   1,
+    1,   1,   1,   1,   2,   2,   2,   3,   3,   4,   5,   6,   6,   7,   8,  10,
+   11,  12,  13,  15,  16,  17,  19,  21,  22,  24,  26,  28,  30,  32,  34,  36,
+   38,  40,  43,  45,  47,  50,  52,  55,  57,  60,  63,  65,  68,  71,  74,  77,
+   79,  82,  85,  88,  91,  94,  97, 100, 103, 106, 109, 112, 116, 119, 122, 125,};
+
+// Perceptual brightness correction (gamma 2.6) for the level of a pixel
+const uint8_t GammaTable[256] = {
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,
+    1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,
+    3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   5,   6,   6,   6,   6,   7,
+    7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  10,  11,  11,  11,  12,  12,
+   13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,
+   20,  21,  21,  22,  22,  23,  24,  24,  25,  25,  26,  27,  27,  28,  29,  29,
+   30,  31,  31,  32,  33,  34,  34,  35,  36,  37,  38,  38,  39,  40,  41,  42,
+   42,  43,  44,  45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,
+   58,  59,  60,  61,  62,  63,  64,  65,  66,  68,  69,  70,  71,  72,  73,  75,
+   76,  77,  78,  80,  81,  82,  84,  85,  86,  88,  89,  90,  92,  93,  94,  96,
+   97,  99, 100, 102, 103, 105, 106, 108, 109, 111, 112, 114, 115, 117, 119, 120,
+  122, 124, 125, 127, 129, 130, 132, 134, 136, 137, 139, 141, 143, 145, 146, 148,
+  150, 152, 154, 156, 158, 160, 162, 164, 166, 168, 170, 172, 174, 176, 178, 180,
+  182, 184, 186, 188, 191, 193, 195, 197, 199, 202, 204, 206, 209, 211, 213, 215,
+  218, 220, 223, 225, 227, 230, 232, 235, 237, 240, 242, 245, 247, 250, 252, 255,};
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Fill in one keyframe
+  * @param  key : Keyframe to fill in
+  * @param  timeMs : When the keyframe is reached
+  * @param  red, green, blue : Color at this keyframe
+  * @param  level : Brightness at this keyframe
+  * @param  ease : How to get to the next keyframe
+  * @retval none
+  */
+void setKeyframe(AnimKeyframe_t * key, uint32_t timeMs, uint8_t red, uint8_t green, uint8_t blue, uint8_t level, uint8_t ease)
+{
+  key->timeMs = timeMs;
+  key->red = red;
+  key->green = green;
+  key->blue = blue;
+  key->level = level;
+  key->ease = ease;
+}
+
+/**
+  * @brief  Blend two 8 bit values in fixed point
+  * @param  from : Value at fraction 0
+  * @param  to : Value at fraction 256
+  * @param  fraction : 0 to 255, how far from 'from' towards 'to'
+  * @retval Blended value
+  */
+inline uint8_t blend8(uint8_t from, uint8_t to, uint8_t fraction)
+{
+  return from + (((int)to - (int)from) * fraction >> 8);
+}
+
+/**
+  * @brief  Find the keyframe segment the given time falls in
+  * @param  anim : Animation to look in (must have a timeline, see hasTimeline)
+  * @param  t : Time within one loop of the animation
+  * @param  endMs : Filled in with the time the segment ends
+  * @retval Index of the keyframe the segment starts at
+  */
+int findSegment(const Animation_t * anim, uint32_t t, uint32_t * endMs)
+{
+  int i = anim->keyframeCount - 1;
+  while (i > 0 && anim->keyframes[i].timeMs > t)
+  {
+    i--;
+  }
+  *endMs = (i + 1 < anim->keyframeCount) ? anim->keyframes[i + 1].timeMs : anim->periodMs;
+  return i;
+}
+
+/**
+  * @brief  Check if an animation's keyframes change over time
+  * @param  anim : Animation to check
+  * @retval true if there is more than one keyframe and a loop length
+  */
+inline bool hasTimeline(const Animation_t * anim)
+{
+  return (anim->keyframeCount > 1 && anim->periodMs > 0);
+}
+
+/**
+  * @brief  Work out the color and brightness the keyframes give at a time
+  * @param  anim : Animation to evaluate
+  * @param  elapsedMs : Time since the animation started
+  * @param  rgb : Filled in with the color
+  * @param  level : Filled in with the brightness (before gamma)
+  * @retval none
+  */
+void evaluateTimeline(const Animation_t * anim, uint32_t elapsedMs, uint8_t rgb[3], uint8_t * level)
+{
+  const AnimKeyframe_t * from = &anim->keyframes[0];
+  const AnimKeyframe_t * to = from;
+  uint8_t fraction = 0;
+
+  if (hasTimeline(anim))
+  {
+    uint32_t t = elapsedMs % anim->periodMs;
+    uint32_t endMs;
+    int i = findSegment(anim, t, &endMs);
+
+    from = &anim->keyframes[i];
+    to = (i + 1 < anim->keyframeCount) ? &anim->keyframes[i + 1] : &anim->keyframes[0];
+    if (endMs > from->timeMs)
+    {
+      uint32_t linear = ((t - from->timeMs) << 8) / (endMs - from->timeMs);
+      switch (from->ease)
+      {
+        case ANIM_EASE_LINEAR:
+          fraction = linear;
+          break;
+
+        case ANIM_EASE_IN_OUT:
+          // Rising half of a cosine, read out of the sine table
+          fraction = 255 - SineTable[(uint8_t)((linear >> 1) + 64)];
+          break;
+
+        case ANIM_EASE_STEP:
+        default:
+          fraction = 0;
+          break;
+      }
+    }
+  }
+
+  rgb[0] = blend8(from->red, to->red, fraction);
+  rgb[1] = blend8(from->green, to->green, fraction);
+  rgb[2] = blend8(from->blue, to->blue, fraction);
+  *level = blend8(from->level, to->level, fraction);
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+void anim_PresetSolid(Animation_t * anim, uint8_t red, uint8_t green, uint8_t blue)
+{
+  memset(anim, 0, sizeof(Animation_t));
+  setKeyframe(&anim->keyframes[0], 0, red, green, blue, 255, ANIM_EASE_STEP);
+  anim->keyframeCount = 1;
+  anim->shape = ANIM_SHAPE_FLAT;
+  anim->fps = ANIM_DEFAULT_FPS;
+}
+
+// See header file for documentation block
+void anim_PresetBlink(Animation_t * anim, uint8_t red, uint8_t green, uint8_t blue, uint32_t onTime, uint32_t offTime)
+{
+  // A zero on or off time would make a zero length segment, so use 1 ms
+  onTime = (onTime > 0) ? onTime : 1;
+  offTime = (offTime > 0) ? offTime : 1;
+
+  anim_PresetSolid(anim, red, green, blue);
+  setKeyframe(&anim->keyframes[1], onTime, red, green, blue, 0, ANIM_EASE_STEP);
+  anim->keyframeCount = 2;
+  anim->periodMs = onTime + offTime;
+}
+
+// See header file for documentation block
+void anim_PresetBreathe(Animation_t * anim, uint8_t red, uint8_t green, uint8_t blue, uint32_t periodMs)
+{
+  periodMs = (periodMs > 1) ? periodMs : 2000;
+
+  anim_PresetSolid(anim, red, green, blue);
+  anim->keyframes[0].ease = ANIM_EASE_IN_OUT;
+  setKeyframe(&anim->keyframes[1], periodMs / 2, red, green, blue, 0, ANIM_EASE_IN_OUT);
+  anim->keyframeCount = 2;
+  anim->periodMs = periodMs;
+}
+
+// See header file for documentation block
+void anim_PresetSwirl(Animation_t * anim, uint8_t red, uint8_t green, uint8_t blue, uint32_t rotationMs)
+{
+  anim_PresetSolid(anim, red, green, blue);
+  anim->shape = ANIM_SHAPE_SWIRL;
+  anim->rotationMs = (rotationMs > 0) ? rotationMs : ANIM_DEFAULT_ROTATION_MS;
+}
+
+// See header file for documentation block
+void anim_PresetChase(Animation_t * anim, uint8_t red, uint8_t green, uint8_t blue, uint32_t rotationMs)
+{
+  anim_PresetSolid(anim, red, green, blue);
+  anim->shape = ANIM_SHAPE_CHASE;
+  anim->rotationMs = (rotationMs > 0) ? rotationMs : ANIM_DEFAULT_ROTATION_MS;
+}
+
+// See header file for documentation block
+bool anim_PresetSeverity(Animation_t * anim, uint8_t severity)
+{
+  switch (severity)
+  {
+    case ANIM_SEVERITY_WARNING:
+      // Fast red strobe
+      anim_PresetBlink(anim, 255, 0, 0, 150, 150);
+      return true;
+
+    case ANIM_SEVERITY_WATCH:
+      // Orange swirl
+      anim_PresetSwirl(anim, 255, 80, 0, 1200);
+      return true;
+
+    case ANIM_SEVERITY_ADVISORY:
+      // Slow yellow breathing
+      anim_PresetBreathe(anim, 255, 180, 0, 3000);
+      return true;
+
+    case ANIM_SEVERITY_INFO:
+      // Very slow, dim blue breathing
+      anim_PresetBreathe(anim, 0, 40, 160, 6000);
+      return true;
+
+    case ANIM_SEVERITY_NONE:
+      anim_PresetSolid(anim, 0, 0, 0);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+// See header file for documentation block
+void anim_Render(const Animation_t * anim, uint32_t elapsedMs, uint8_t frame[][3], int numPixels)
+{
+  uint8_t rgb[3];
+  uint8_t level;
+  uint32_t rotationMs = (anim->rotationMs > 0) ? anim->rotationMs : ANIM_DEFAULT_ROTATION_MS;
+  uint32_t rotation = elapsedMs % rotationMs;
+
+  evaluateTimeline(anim, elapsedMs, rgb, &level);
+
+  for (int i = 0; i < numPixels; i++)
+  {
+    uint32_t shape;
+
+    switch (anim->shape)
+    {
+      case ANIM_SHAPE_SWIRL:
+      {
+        uint8_t phase = (uint8_t)(((uint64_t)rotation << 8) / rotationMs);
+        shape = SineTable[(uint8_t)((i << 8) / numPixels + phase)];
+        break;
+      }
+
+      case ANIM_SHAPE_CHASE:
+      {
+        // Positions in 8.8 fixed point pixels
+        uint32_t ring = (uint32_t)numPixels << 8;
+        uint32_t head = (uint32_t)(((uint64_t)rotation * ring) / rotationMs);
+        uint32_t distance = (head + ring - ((uint32_t)i << 8)) % ring;
+        uint32_t tail = ANIM_CHASE_TAIL << 8;
+        shape = (distance < tail) ? 255 - (distance * 255) / tail : 0;
+        break;
+      }
+
+      case ANIM_SHAPE_FLAT:
+      default:
+        shape = 255;
+        break;
+    }
+
+    uint32_t pixelLevel = GammaTable[(level * shape + 255) >> 8] + 1;
+    frame[i][0] = (rgb[0] * pixelLevel) >> 8;
+    frame[i][1] = (rgb[1] * pixelLevel) >> 8;
+    frame[i][2] = (rgb[2] * pixelLevel) >> 8;
+  }
+}
+
+// See header file for documentation block
+uint32_t anim_NextFrameMs(const Animation_t * anim, uint32_t elapsedMs)
+{
+  uint32_t frameMs = 1000 / ((anim->fps > 0) ? anim->fps : ANIM_DEFAULT_FPS);
+
+  // Moving shapes need every frame
+  if (anim->shape != ANIM_SHAPE_FLAT)
+  {
+    return frameMs;
+  }
+
+  if (!hasTimeline(anim))
+  {
+    return ANIM_FOREVER;
+  }
+
+  // Step segments only need a frame at their end. Smooth ones need every
+  // frame, but still land exactly on the end of the segment.
+  uint32_t t = elapsedMs % anim->periodMs;
+  uint32_t endMs;
+  int i = findSegment(anim, t, &endMs);
+  uint32_t untilEnd = endMs - t;
+
+  if (anim->keyframes[i].ease == ANIM_EASE_STEP || untilEnd < frameMs)
+  {
+    return untilEnd;
+  }
+  return frameMs;
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+/**
+  ******************************************************************************
+  * @file    arena.cpp
+  * @author  Brian Schmalz
+  * @brief   Fixed memory POST bodies are parsed in
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "arena.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+void arena_Release(ArenaHeader_t * arena)
+{
+  arena->inUse = false;
+}
+
+// See header file for documentation block
+void arena_Append(ArenaHeader_t * arena, const uint8_t * data, size_t len, size_t index, size_t total)
+{
+  if (arena->overflow)
+  {
+    return;
+  }
+  if (total > arena->size)
+  {
+    arena->overflow = true;
+    return;
+  }
+
+  memcpy(arena->body + index, data, len);
+  arena->length = index + len;
+  if (arena->length == total)
+  {
+    arena->body[total] = '\0';
+  }
+}
+
+// See header file for documentation block
+DeserializationError arena_Parse(ArenaHeader_t * arena)
+{
+  // Given a char *, ArduinoJson parses in place
+  return deserializeJson(*arena->doc, arena->body, arena->length);
+}
\ No newline at end of file
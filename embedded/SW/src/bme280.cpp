@@ -0,0 +1,364 @@
+/**
+  ******************************************************************************
+  * @file    bme280.cpp
+  * @author  Brian Schmalz
+  * @brief   Register level BME280 driver
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include "bme280.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+// Registers
+#define BME280_REG_CALIB_TP     0x88    // dig_T1 .. dig_H1, 26 bytes
+#define BME280_REG_CHIP_ID      0xD0
+#define BME280_REG_RESET        0xE0
+#define BME280_REG_CALIB_H      0xE1    // dig_H2 .. dig_H6, 7 bytes
+#define BME280_REG_CTRL_HUM     0xF2
+#define BME280_REG_STATUS       0xF3
+#define BME280_REG_CTRL_MEAS    0xF4
+#define BME280_REG_CONFIG       0xF5
+#define BME280_REG_DATA         0xF7    // press, temp, hum, 8 bytes
+
+#define BME280_CHIP_ID          0x60
+#define BME280_RESET_WORD       0xB6
+#define BME280_STATUS_MEASURING 0x08
+#define BME280_STATUS_IM_UPDATE 0x01
+
+#define BME280_CALIB_TP_SIZE    26
+#define BME280_CALIB_H_SIZE     7
+#define BME280_DATA_SIZE        8
+
+// Raw values the chip reports for a skipped channel
+#define BME280_SKIPPED_20BIT    0x80000
+#define BME280_SKIPPED_16BIT    0x8000
+
+// Extra status polls, one tick apart, if a forced conversion overruns the datasheet maximum
+#define BME280_MEASURE_POLLS    5
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+// Samples averaged for each BME280Oversample_t
+const uint8_t OversampleCount[] = { 0, 1, 2, 4, 8, 16 };
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Read consecutive registers in one I2C transaction (register
+  *         address write, repeated start, burst read).
+  * @param  reg : first register
+  * @param  data : filled in with the register values
+  * @param  length : number of registers to read
+  * @retval true if all bytes were read
+  */
+bool BME280::readRegisters(uint8_t reg, uint8_t * data, uint8_t length)
+{
+  uint32_t start = micros();
+  bool ok = false;
+
+  wire->beginTransmission(address);
+  wire->write(reg);
+  if (wire->endTransmission(false) == 0 &&
+      wire->requestFrom(address, length) == length)
+  {
+    for (uint8_t i = 0; i < length; i++)
+    {
+      data[i] = wire->read();
+    }
+    ok = true;
+  }
+  busUs += micros() - start;
+  return ok;
+}
+
+/**
+  * @brief  Write one register
+  * @param  reg : register to write
+  * @param  value : value to write
+  * @retval true if the chip acknowledged
+  */
+bool BME280::writeRegister(uint8_t reg, uint8_t value)
+{
+  uint32_t start = micros();
+  bool ok;
+
+  wire->beginTransmission(address);
+  wire->write(reg);
+  wire->write(value);
+  ok = (wire->endTransmission() == 0);
+  busUs += micros() - start;
+  return ok;
+}
+
+/**
+  * @brief  Load the trimming parameters from the chip's NVM
+  * @retval true on success
+  */
+bool BME280::readCalibration(void)
+{
+  uint8_t tp[BME280_CALIB_TP_SIZE];
+  uint8_t h[BME280_CALIB_H_SIZE];
+
+  if (!readRegisters(BME280_REG_CALIB_TP, tp, sizeof(tp)) ||
+      !readRegisters(BME280_REG_CALIB_H, h, sizeof(h)))
+  {
+    return false;
+  }
+
+  digT1 = (uint16_t)(tp[1] << 8 | tp[0]);
+  digT2 = (int16_t)(tp[3] << 8 | tp[2]);
+  digT3 = (int16_t)(tp[5] << 8 | tp[4]);
+  digP1 = (uint16_t)(tp[7] << 8 | tp[6]);
+  digP2 = (int16_t)(tp[9] << 8 | tp[8]);
+  digP3 = (int16_t)(tp[11] << 8 | tp[10]);
+  digP4 = (int16_t)(tp[13] << 8 | tp[12]);
+  digP5 = (int16_t)(tp[15] << 8 | tp[14]);
+  digP6 = (int16_t)(tp[17] << 8 | tp[16]);
+  digP7 = (int16_t)(tp[19] << 8 | tp[18]);
+  digP8 = (int16_t)(tp[21] << 8 | tp[20]);
+  digP9 = (int16_t)(tp[23] << 8 | tp[22]);
+  digH1 = tp[25];
+
+  // dig_H4 and dig_H5 are 12 bit signed values sharing register 0xE5
+  digH2 = (int16_t)(h[1] << 8 | h[0]);
+  digH3 = h[2];
+  digH4 = (int16_t)((int8_t)h[3] * 16 | (h[4] & 0x0F));
+  digH5 = (int16_t)((int8_t)h[5] * 16 | (h[4] >> 4));
+  digH6 = (int8_t)h[6];
+  return true;
+}
+
+/**
+  * @brief  Datasheet integer temperature compensation. Also updates tFine,
+  *         so it must run before the pressure and humidity formulas.
+  * @param  adc : raw 20 bit temperature
+  * @retval temperature in 0.01 deg C
+  */
+int32_t BME280::compensateTemperature(int32_t adc)
+{
+  int32_t var1, var2;
+
+  var1 = ((((adc >> 3) - ((int32_t)digT1 << 1))) * ((int32_t)digT2)) >> 11;
+  var2 = (((((adc >> 4) - ((int32_t)digT1)) * ((adc >> 4) - ((int32_t)digT1))) >> 12) *
+          ((int32_t)digT3)) >> 14;
+  tFine = var1 + var2;
+  return (tFine * 5 + 128) >> 8;
+}
+
+/**
+  * @brief  Datasheet 64 bit integer pressure compensation
+  * @param  adc : raw 20 bit pressure
+  * @retval pressure in Pa, Q24.8
+  */
+uint32_t BME280::compensatePressure(int32_t adc)
+{
+  int64_t var1, var2, p;
+
+  var1 = ((int64_t)tFine) - 128000;
+  var2 = var1 * var1 * (int64_t)digP6;
+  var2 = var2 + ((var1 * (int64_t)digP5) << 17);
+  var2 = var2 + (((int64_t)digP4) << 35);
+  var1 = ((var1 * var1 * (int64_t)digP3) >> 8) + ((var1 * (int64_t)digP2) << 12);
+  var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)digP1) >> 33;
+  if (var1 == 0)
+  {
+    // Avoid dividing by zero on an unprogrammed chip
+    return 0;
+  }
+  p = 1048576 - adc;
+  p = (((p << 31) - var2) * 3125) / var1;
+  var1 = (((int64_t)digP9) * (p >> 13) * (p >> 13)) >> 25;
+  var2 = (((int64_t)digP8) * p) >> 19;
+  p = ((p + var1 + var2) >> 8) + (((int64_t)digP7) << 4);
+  return (uint32_t)p;
+}
+
+/**
+  * @brief  Datasheet integer humidity compensation
+  * @param  adc : raw 16 bit humidity
+  * @retval humidity in %RH, Q22.10
+  */
+uint32_t BME280::compensateHumidity(int32_t adc)
+{
+  int32_t v;
+
+  v = tFine - ((int32_t)76800);
+  v = (((((adc << 14) - (((int32_t)digH4) << 20) - (((int32_t)digH5) * v)) +
+         ((int32_t)16384)) >> 15) *
+       (((((((v * ((int32_t)digH6)) >> 10) * (((v * ((int32_t)digH3)) >> 11) +
+         ((int32_t)32768))) >> 10) + ((int32_t)2097152)) * ((int32_t)digH2) + 8192) >> 14));
+  v = (v - (((((v >> 15) * (v >> 15)) >> 7) * ((int32_t)digH1)) >> 4));
+  v = (v < 0) ? 0 : v;
+  v = (v > 419430400) ? 419430400 : v;
+  return (uint32_t)(v >> 12);
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+BME280::BME280(TwoWire & wire, uint8_t address)
+{
+  this->wire = &wire;
+  this->address = address;
+  memset(&config, 0, sizeof(config));
+  busUs = 0;
+  tFine = 0;
+}
+
+bool BME280::begin(const BME280Config_t & config)
+{
+  uint8_t id;
+  uint8_t status;
+
+  if (!readRegisters(BME280_REG_CHIP_ID, &id, 1) || id != BME280_CHIP_ID)
+  {
+    return false;
+  }
+
+  // Soft reset, then wait for the NVM calibration data to be copied in
+  writeRegister(BME280_REG_RESET, BME280_RESET_WORD);
+  delay(3);
+  for (int tries = 0; tries < 10; tries++)
+  {
+    if (!readRegisters(BME280_REG_STATUS, &status, 1))
+    {
+      return false;
+    }
+    if ((status & BME280_STATUS_IM_UPDATE) == 0)
+    {
+      break;
+    }
+    delay(1);
+  }
+
+  if (!readCalibration())
+  {
+    return false;
+  }
+  return configure(config);
+}
+
+bool BME280::configure(const BME280Config_t & config)
+{
+  this->config = config;
+
+  // Settings only take effect reliably in sleep mode. ctrl_hum is latched by
+  // the following ctrl_meas write.
+  return writeRegister(BME280_REG_CTRL_MEAS, BME280_MODE_SLEEP) &&
+         writeRegister(BME280_REG_CONFIG, (config.standby << 5) | (config.filter << 2)) &&
+         writeRegister(BME280_REG_CTRL_HUM, config.humidity) &&
+         writeRegister(BME280_REG_CTRL_MEAS,
+                       (config.temperature << 5) | (config.pressure << 2) |
+                       (config.mode == BME280_MODE_NORMAL ? BME280_MODE_NORMAL : BME280_MODE_SLEEP));
+}
+
+bool BME280::read(BME280Sample_t * sample)
+{
+  uint8_t data[BME280_DATA_SIZE];
+  int32_t adcP, adcT, adcH;
+
+  busUs = 0;
+
+  if (config.mode == BME280_MODE_FORCED)
+  {
+    uint8_t status;
+
+    if (!writeRegister(BME280_REG_CTRL_MEAS,
+                       (config.temperature << 5) | (config.pressure << 2) | BME280_MODE_FORCED))
+    {
+      return false;
+    }
+
+    // Sleep through the conversion rather than polling the bus
+    vTaskDelay(pdMS_TO_TICKS((measureTimeUs() + 999) / 1000) + 1);
+    for (int polls = 0; ; polls++)
+    {
+      if (!readRegisters(BME280_REG_STATUS, &status, 1))
+      {
+        return false;
+      }
+      if ((status & BME280_STATUS_MEASURING) == 0)
+      {
+        break;
+      }
+      if (polls >= BME280_MEASURE_POLLS)
+      {
+        return false;
+      }
+      vTaskDelay(1);
+    }
+  }
+
+  // All data registers in one burst, so every channel is from the same conversion
+  if (!readRegisters(BME280_REG_DATA, data, sizeof(data)))
+  {
+    return false;
+  }
+
+  adcP = (int32_t)data[0] << 12 | (int32_t)data[1] << 4 | data[2] >> 4;
+  adcT = (int32_t)data[3] << 12 | (int32_t)data[4] << 4 | data[5] >> 4;
+  adcH = (int32_t)data[6] << 8 | data[7];
+
+  // Temperature is needed for t_fine even if only the other channels are wanted
+  if (adcT == BME280_SKIPPED_20BIT)
+  {
+    return false;
+  }
+  sample->temperature = compensateTemperature(adcT);
+  sample->pressure = (adcP == BME280_SKIPPED_20BIT) ? 0 : compensatePressure(adcP);
+  sample->humidity = (adcH == BME280_SKIPPED_16BIT) ? 0 : compensateHumidity(adcH);
+  sample->busUs = busUs;
+  return true;
+}
+
+uint32_t BME280::measureTimeUs(void) const
+{
+  // Maximum measurement time from datasheet section 9.1
+  uint32_t us = 1250 + 2300 * OversampleCount[config.temperature];
+
+  if (config.pressure != BME280_OVERSAMPLE_SKIP)
+  {
+    us += 2300 * OversampleCount[config.pressure] + 575;
+  }
+  if (config.humidity != BME280_OVERSAMPLE_SKIP)
+  {
+    us += 2300 * OversampleCount[config.humidity] + 575;
+  }
+  return us;
+}
\ No newline at end of file
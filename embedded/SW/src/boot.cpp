@@ -0,0 +1,159 @@
+/**
+  ******************************************************************************
+  * @file    boot.cpp
+  * @author  Brian Schmalz
+  * @brief   Boot sequencing and per-stage boot timing
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include "boot.h"
+#include "logger.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+// An init function run in its own task by boot_Start()
+typedef struct {
+  void (*init)(void);
+  BootStage_t stage;
+  TaskId_t task;
+} BootJob_t;
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+static const char * const StageNames[BOOT_STAGE_COUNT] = {
+  "setup", "wifi_start", "led", "sensor", "lcd", "render",
+  "wifi_connected", "got_ip", "server", "first_request"
+};
+
+// When each stage was reached (esp_timer_get_time()), 0 if not yet
+static int64_t StageUs[BOOT_STAGE_COUNT];
+static portMUX_TYPE BootLock = portMUX_INITIALIZER_UNLOCKED;
+
+// One bit per stage reached, for boot_Wait()
+static EventGroupHandle_t BootEvents = NULL;
+
+// Jobs handed to the init tasks. A stage is only started once.
+static BootJob_t BootJobs[BOOT_STAGE_COUNT];
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Init task. Runs one init function, marks its stage and exits.
+  * @param  parameter : the BootJob_t to run
+  * @retval none
+  */
+static void runBootJob(void * parameter)
+{
+  BootJob_t * job = (BootJob_t *)parameter;
+
+  job->init();
+  boot_Mark(job->stage);
+  topology_Exit(job->task);
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+void boot_Init(void)
+{
+  BootEvents = xEventGroupCreate();
+  boot_Mark(BOOT_STAGE_SETUP);
+}
+
+// See header file for documentation block
+void boot_Mark(BootStage_t stage)
+{
+  int64_t now = esp_timer_get_time();
+  bool first = false;
+
+  portENTER_CRITICAL(&BootLock);
+  if (StageUs[stage] == 0)
+  {
+    StageUs[stage] = now;
+    first = true;
+  }
+  portEXIT_CRITICAL(&BootLock);
+
+  if (first)
+  {
+    xEventGroupSetBits(BootEvents, BOOT_BIT(stage));
+    LOGGER_INFO("Boot %s at %u ms", StageNames[stage], (unsigned)(now / 1000));
+  }
+}
+
+// See header file for documentation block
+void boot_Start(TaskId_t task, void (*init)(void), BootStage_t stage)
+{
+  BootJobs[stage].init = init;
+  BootJobs[stage].stage = stage;
+  BootJobs[stage].task = task;
+
+  if (!topology_Create(task, runBootJob, &BootJobs[stage], NULL))
+  {
+    // Not enough RAM for the task, so do it the slow way
+    LOGGER_WARN("Running boot stage %s inline", StageNames[stage]);
+    init();
+    boot_Mark(stage);
+  }
+}
+
+// See header file for documentation block
+bool boot_Wait(uint32_t stages, uint32_t timeoutMs)
+{
+  TickType_t ticks = (timeoutMs == BOOT_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+  EventBits_t bits = xEventGroupWaitBits(BootEvents, stages, pdFALSE, pdTRUE, ticks);
+  return (bits & stages) == stages;
+}
+
+// See header file for documentation block
+int64_t boot_GetStageUs(BootStage_t stage)
+{
+  portENTER_CRITICAL(&BootLock);
+  int64_t us = StageUs[stage];
+  portEXIT_CRITICAL(&BootLock);
+  return us;
+}
+
+// See header file for documentation block
+const char * boot_GetStageName(BootStage_t stage)
+{
+  return StageNames[stage];
+}
\ No newline at end of file
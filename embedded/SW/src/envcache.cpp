@@ -0,0 +1,213 @@
+/**
+  ******************************************************************************
+  * @file    envcache.cpp
+  * @author  Brian Schmalz
+  * @brief   Pre-serialized, versioned sensor response cache
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <atomic>
+#include "envcache.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+// Every response for one published sample
+typedef struct {
+  char body[ENV_COUNT][ENVCACHE_BODY_SIZE];
+  size_t length[ENV_COUNT];
+  char etag[ENVCACHE_ETAG_SIZE];
+  uint32_t version;
+} EnvCacheSlot_t;
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/// NOTE: Two slots are used so the sensor task can build the next sample's
+/// responses while handlers copy from the current one. A slot is only
+/// rewritten once it has stopped being current (and again for each sample
+/// that turns out unchanged), so only a reader preempted across a publish
+/// could see a half written body. envcache_Get()
+/// copies the body out and retries if Published moved during the copy, so
+/// nothing outside this file ever points into a slot.
+static EnvCacheSlot_t Slots[2];
+
+// Index of the slot handlers should read, or -1 before the first sample
+static std::atomic<int> CurrentSlot(-1);
+
+// Number of samples published, bumped once a new slot is current
+static std::atomic<uint32_t> Published(0);
+
+// Random per-boot prefix so ETags from before a reboot never match
+static uint32_t BootId;
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Serialize one sensor value as a {type, value, unit} JSON object
+  * @param  slot : Slot to write the body into
+  * @param  which : Which resource this body is for
+  * @param  tag : string name for tag element
+  * @param  value : numerical value element
+  * @param  unit : string name for units element
+  * @retval none
+  */
+static void buildSingle(EnvCacheSlot_t * slot, EnvResource_t which, const char * tag, float value, const char * unit)
+{
+  StaticJsonDocument<128> doc;
+  doc["type"] = tag;
+  doc["value"] = value;
+  doc["unit"] = unit;
+  slot->length[which] = serializeJson(doc, slot->body[which], ENVCACHE_BODY_SIZE);
+}
+
+/**
+  * @brief  Add one sensor value as a {type, value, unit} object to an array
+  * @param  array : Array to add the object to
+  * @param  tag : string name for tag element
+  * @param  value : numerical value element
+  * @param  unit : string name for units element
+  * @retval none
+  */
+static void addObject(JsonArray array, const char * tag, float value, const char * unit)
+{
+  JsonObject obj = array.createNestedObject();
+  obj["type"] = tag;
+  obj["value"] = value;
+  obj["unit"] = unit;
+}
+
+/**
+  * @brief  Whether two slots hold the same responses
+  * @param  a : one slot
+  * @param  b : the other
+  * @retval true if every body is the same
+  */
+static bool sameBodies(const EnvCacheSlot_t * a, const EnvCacheSlot_t * b)
+{
+  for (int i = 0; i < ENV_COUNT; i++)
+  {
+    if (a->length[i] != b->length[i] || memcmp(a->body[i], b->body[i], a->length[i]) != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+void envcache_Publish(float temperature, float humidity, float pressure)
+{
+  int current = CurrentSlot.load(std::memory_order_acquire);
+  int next = (current == 0) ? 1 : 0;
+  EnvCacheSlot_t * slot = &Slots[next];
+
+  buildSingle(slot, ENV_TEMPERATURE, "temperature", temperature, "°C");
+  buildSingle(slot, ENV_HUMIDITY, "humidity", humidity, "%");
+  buildSingle(slot, ENV_PRESSURE, "pressure", pressure, "mBar");
+
+  StaticJsonDocument<384> doc;
+  JsonArray array = doc.to<JsonArray>();
+  addObject(array, "temperature", temperature, "°C");
+  addObject(array, "humidity", humidity, "%");
+  addObject(array, "pressure", pressure, "mBar");
+  slot->length[ENV_ALL] = serializeJson(doc, slot->body[ENV_ALL], ENVCACHE_BODY_SIZE);
+
+  // A sample that reads the same as the last one keeps its version and
+  // ETag, so clients polling with If-None-Match keep getting 304
+  if (current >= 0 && sameBodies(slot, &Slots[current]))
+  {
+    return;
+  }
+
+  if (current < 0)
+  {
+    BootId = esp_random();
+    slot->version = 1;
+  }
+  else
+  {
+    slot->version = Slots[current].version + 1;
+  }
+  snprintf(slot->etag, ENVCACHE_ETAG_SIZE, "\"%08x-%u\"", (unsigned)BootId, (unsigned)slot->version);
+
+  // Make the new responses visible to handlers only once they are complete
+  CurrentSlot.store(next, std::memory_order_release);
+  Published.fetch_add(1, std::memory_order_release);
+}
+
+// See header file for documentation block
+bool envcache_Get(EnvResource_t which, EnvResponse_t * response)
+{
+  if (which >= ENV_COUNT)
+  {
+    return false;
+  }
+
+  for (;;)
+  {
+    uint32_t published = Published.load(std::memory_order_acquire);
+    int current = CurrentSlot.load(std::memory_order_acquire);
+    if (current < 0)
+    {
+      return false;
+    }
+
+    const EnvCacheSlot_t * slot = &Slots[current];
+    size_t length = slot->length[which];
+    if (length >= ENVCACHE_BODY_SIZE)
+    {
+      length = ENVCACHE_BODY_SIZE - 1;
+    }
+    memcpy(response->body, slot->body[which], length);
+    response->body[length] = '\0';
+    response->length = length;
+    memcpy(response->etag, slot->etag, ENVCACHE_ETAG_SIZE);
+    response->etag[ENVCACHE_ETAG_SIZE - 1] = '\0';
+    response->version = slot->version;
+
+    // The slot can only have been rewritten if another sample was published
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (Published.load(std::memory_order_relaxed) == published)
+    {
+      return true;
+    }
+  }
+}
\ No newline at end of file
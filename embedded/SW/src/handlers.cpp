@@ -37,25 +37,107 @@
 #include <WiFi.h>
 #include <FreeRTOS.h>
 #include <ArduinoJson.h>
-#include <WebServer.h>
-#include "sensor.hpp"
-#include "led.h"
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
+#include <memory>
+#include <esp_system.h>
+#include "arena.h"
+#include "boot.h"
+#include "envcache.h"
+#include "history.h"
+#include "taskstats.h"
+#include "trend.h"
+#include "wifimgr.h"
+#include "logger.h"
+#include "metrics.h"
+#include "render.h"
+#include "anim.h"
 #include "lcd.h"
 
 /* Private typedef -----------------------------------------------------------*/
 
+// State of one streamed /history response
+typedef struct {
+  HistoryQuery_t query;
+  char line[96];            // Piece of the response being sent
+  size_t length;            // Bytes in line
+  size_t sent;              // Bytes of line already sent
+  bool first;               // No sample written yet
+  bool done;                // line holds the closing brackets
+} HistoryStream_t;
+
+// State of one streamed /debug/tasks response
+typedef struct {
+  TaskStatsQuery_t query;
+  char line[192];           // Piece of the response being sent
+  size_t length;            // Bytes in line
+  size_t sent;              // Bytes of line already sent
+  bool first;               // No task written yet
+  bool done;                // line holds the closing brackets
+} TasksStream_t;
+
+// State of one streamed /metrics response
+typedef struct {
+  MetricsCursor_t cursor;
+  char line[METRICS_LINE_SIZE];  // Line being sent
+  size_t length;            // Bytes in line
+  size_t sent;              // Bytes of line already sent
+} MetricsStream_t;
+
+// Asks the server to keep the If-None-Match header, which it drops unless
+// a handler is interested in it, so sendEnv() can answer 304. Never
+// handles a request itself.
+class ConditionalHeaders : public AsyncWebHandler {
+public:
+  bool canHandle(AsyncWebServerRequest *request) override
+  {
+    if (request->method() == HTTP_GET)
+    {
+      request->addInterestingHeader("If-None-Match");
+    }
+    return false;
+  }
+};
+
+// Sees every request before the endpoints do, to time the first one after
+// boot. Never handles a request itself.
+class BootRequestMarker : public AsyncWebHandler {
+public:
+  bool canHandle(AsyncWebServerRequest *request) override
+  {
+    boot_Mark(BOOT_STAGE_FIRST_REQUEST);
+    return false;
+  }
+};
+
 /* Private define ------------------------------------------------------------*/
 
+// Requests to one POST route that can be receiving or being handled at
+// the same time. Any more are answered with 429.
+#ifndef HANDLERS_ARENAS
+#define HANDLERS_ARENAS 2
+#endif
+
 /* Private macro -------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
 
-// Web server running on port 80
-WebServer server(80);
+// Event driven web server running on port 80. Requests are parsed and
+// dispatched from the AsyncTCP task, so several connections can be in
+// flight at the same time and nothing needs to poll from loop().
+AsyncWebServer server(80);
+
+// Registered ahead of every endpoint
+BootRequestMarker FirstRequestMarker;
+ConditionalHeaders EnvHeaders;
 
-// JSON data buffer
-StaticJsonDocument<500> jsonDocument;
-char buffer[500];
+// Arenas of each POST route, handed out per request
+/// NOTE: Bodies, handlers and disconnects are all run by the single AsyncTCP
+/// task, so taking and giving back arenas needs no lock.
+LedArena_t LedArenas[HANDLERS_ARENAS];
+LcdArena_t LcdArenas[HANDLERS_ARENAS];
+IconArena_t IconArenas[HANDLERS_ARENAS];
+StateArena_t StateArenas[HANDLERS_ARENAS];
 
 /* Public variables ----------------------------------------------------------*/
 
@@ -64,215 +146,1077 @@ char buffer[500];
 /* Private functions ---------------------------------------------------------*/
 
 /**
-  * @brief  Creates JSON data in buffer from one piece ofsensor data
-  * @param  tag : string name for tag element
-  * @param  value : numerical value element
-  * @param  unit : string name for units element
+  * @brief  Respond to a request with an error status and a JSON error message
+  * @param  request : the incoming request
+  * @param  code : HTTP status code to send
+  * @param  message : short description of the error
   * @retval none
   */
-void create_json(char *tag, float value, char *unit) 
-{ 
-  jsonDocument.clear(); 
-  jsonDocument["type"] = tag;
-  jsonDocument["value"] = value;
-  jsonDocument["unit"] = unit;
-  serializeJson(jsonDocument, buffer);
-  Serial.println("Buffer:");
-  Serial.println(buffer);  
+void sendError(AsyncWebServerRequest *request, int code, const char * message)
+{
+  char body[64];
+
+  metrics_Increment(METRIC_ERRORS);
+  snprintf(body, sizeof(body), "{\"error\":\"%s\"}", message);
+  request->send(code, "application/json", body);
 }
- 
+
+/**
+  * @brief  Body callback for POST endpoints. The body may arrive in several
+  *         TCP segments, so collect it into an arena of the route taken for
+  *         the request. The arena is given back when the connection closes.
+  * @param  request : request the body belongs to
+  * @param  data : this chunk of the body
+  * @param  len : number of bytes in this chunk
+  * @param  index : offset of this chunk within the body
+  * @param  total : total length of the body
+  * @retval none
+  */
+template <typename Arena, Arena * Pool>
+void collectBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)
+{
+  ArenaHeader_t *arena = (ArenaHeader_t *)request->_tempObject;
+
+  if (index == 0 && arena == NULL)
+  {
+    arena = arena_Take(Pool, HANDLERS_ARENAS);
+    if (arena == NULL)
+    {
+      return;
+    }
+    request->_tempObject = arena;
+
+    // The server frees _tempObject when it deletes the request, and this
+    // runs just before, so hand the arena back and take it away from it
+    request->onDisconnect([request, arena]()
+    {
+      arena_Release(arena);
+      request->_tempObject = NULL;
+    });
+  }
+
+  if (arena != NULL)
+  {
+    arena_Append(arena, data, len, index, total);
+  }
+}
+
 /**
-  * @brief  Add one new sensor value into existing JSON document
-  * @param  tag : string name for tag element
-  * @param  value : numerical value element
-  * @param  unit : string name for units element
+  * @brief  Return the arena holding the complete body of a POST request, or
+  *         NULL (after responding with an error) if no usable body was received
+  * @param  request : request to get the body for
+  * @retval Arena with a zero terminated body, or NULL
+  */
+ArenaHeader_t * getBody(AsyncWebServerRequest *request)
+{
+  ArenaHeader_t *arena = (ArenaHeader_t *)request->_tempObject;
+
+  if (arena == NULL && request->contentLength() > 0)
+  {
+    // Every arena of this route was taken
+    metrics_Increment(METRIC_ERRORS);
+    AsyncWebServerResponse *response = request->beginResponse(429, "application/json", "{\"error\":\"busy\"}");
+    response->addHeader("Retry-After", "1");
+    request->send(response);
+    return NULL;
+  }
+  if (arena == NULL || arena->length == 0)
+  {
+    sendError(request, 400, "missing body");
+    return NULL;
+  }
+  if (arena->overflow)
+  {
+    sendError(request, 413, "body too large");
+    return NULL;
+  }
+  LOGGER_DEBUG("%s body: %s", request->url().c_str(), arena->body);
+  return arena;
+}
+
+/**
+  * @brief  Send the cached JSON response for one sensor resource. If the
+  *         client already has this version (If-None-Match matches the ETag)
+  *         answer 304 with no body.
+  * @param  request : the incoming request
+  * @param  which : which sensor resource to send
   * @retval none
   */
-void add_json_object(char *tag, float value, char *unit) 
+void sendEnv(AsyncWebServerRequest *request, EnvResource_t which)
 {
-  JsonObject obj = jsonDocument.createNestedObject();
-  obj["type"] = tag;
-  obj["value"] = value;
-  obj["unit"] = unit; 
+  EnvResponse_t env;
+  AsyncWebServerResponse *response;
+
+  if (!envcache_Get(which, &env))
+  {
+    sendError(request, 503, "no sample yet");
+    return;
+  }
+
+  if (request->hasHeader("If-None-Match") &&
+      request->header("If-None-Match").equals(env.etag))
+  {
+    response = request->beginResponse(304);
+  }
+  else
+  {
+    // The response owns its copy of the body, so it can be sent to a slow
+    // client while the cache moves on to newer samples
+    response = request->beginResponse(200, "application/json", String(env.body));
+  }
+  response->addHeader("ETag", env.etag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
 }
 
 /**
   * @brief  Called when /temperature endpoint is accessed. Return temp JSON
-  * @param  none
+  * @param  request : the incoming request
   * @retval none
   */
-void getTemperature(void) 
+void getTemperature(AsyncWebServerRequest *request) 
 {
-  char tag[] = "temperature";
-  char unit[] = "°C";
-  Serial.println("Get temperature");
-  create_json(tag, sensor_GetTemperature(), unit);
-  server.send(200, "application/json", buffer);
+  MetricsScope timer(METRIC_HANDLER_TEMPERATURE);
+  metrics_Increment(METRIC_REQUESTS);
+  LOGGER_DEBUG("Get temperature");
+  sendEnv(request, ENV_TEMPERATURE);
 }
  
 /**
   * @brief  Called when /humidity endpoint is accessed. Return humidity JSON
-  * @param  none
+  * @param  request : the incoming request
   * @retval none
   */
-void getHumidity(void) 
+void getHumidity(AsyncWebServerRequest *request) 
 {
-  char tag[] = "humidity";
-  char unit[] = "%";
-  Serial.println("Get humidity");
-  create_json(tag, sensor_GetHumidity(), unit);
-  server.send(200, "application/json", buffer);
+  MetricsScope timer(METRIC_HANDLER_HUMIDITY);
+  metrics_Increment(METRIC_REQUESTS);
+  LOGGER_DEBUG("Get humidity");
+  sendEnv(request, ENV_HUMIDITY);
 }
  
 /**
   * @brief  Called whne /pressure endpoint is accessed. Return pressure JSON
-  * @param  none
+  * @param  request : the incoming request
   * @retval none
   */
-void getPressure(void) 
+void getPressure(AsyncWebServerRequest *request) 
 {
-  char tag[] = "pressure";
-  char unit[] = "mBar";
-  Serial.println("Get pressure");
-  create_json(tag, sensor_GetPressure(), unit);
-  server.send(200, "application/json", buffer);
+  MetricsScope timer(METRIC_HANDLER_PRESSURE);
+  metrics_Increment(METRIC_REQUESTS);
+  LOGGER_DEBUG("Get pressure");
+  sendEnv(request, ENV_PRESSURE);
 }
  
 /**
-  * @brief  Called when /env endpoint is accessed. Return all three values in JSON response
-  * @param  none
+  * @brief  Send the current readings together with the rolling statistics
+  *         and the local alert rules that are raised:
+  *         {"env": [...as /env...], "stats": {"samples": n, "rules": [...],
+  *          "<channel>": {"ewma": x, "1h": {"min", "max", "mean", "slope",
+  *          "minutes"}, "3h": {...}, "6h": {...}}, ...}}
+  * @param  request : the incoming request
   * @retval none
   */
-void getEnv(void) 
+void sendStats(AsyncWebServerRequest *request)
 {
-  char tag1[] = "temperature";
-  char tag2[] = "humidity";
-  char tag3[] = "pressure";
-  char unit1[] = "°C";
-  char unit2[] = "%";
-  char unit3[] = "mBar";
-  Serial.println("Get env");
-  jsonDocument.clear();
-  add_json_object(tag1, sensor_GetTemperature(), unit1);
-  add_json_object(tag2, sensor_GetHumidity(), unit2);
-  add_json_object(tag3, sensor_GetPressure(), unit3);
-  serializeJson(jsonDocument, buffer);
-  server.send(200, "application/json", buffer);
+  static const char * const channels[TREND_CHANNELS] = { "temperature", "humidity", "pressure" };
+  EnvResponse_t env;
+  TrendStats_t stats;
+  bool first = true;
+
+  if (!envcache_Get(ENV_ALL, &env))
+  {
+    sendError(request, 503, "no sample yet");
+    return;
+  }
+  trend_GetStats(&stats);
+
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  response->print("{\"env\":");
+  response->write((const uint8_t *)env.body, env.length);
+  response->printf(",\"stats\":{\"samples\":%u,\"rules\":[", (unsigned)stats.samples);
+  for (uint8_t r = 0; trend_GetRuleName(r) != NULL; r++)
+  {
+    if (stats.activeRules & (1UL << r))
+    {
+      response->printf("%s\"%s\"", first ? "" : ",", trend_GetRuleName(r));
+      first = false;
+    }
+  }
+  response->print("]");
+  for (int c = 0; c < TREND_CHANNELS; c++)
+  {
+    const TrendChannelStats_t * channel = &stats.channel[c];
+    response->printf(",\"%s\":{\"ewma\":%.3f", channels[c], channel->ewma);
+    for (int w = 0; w < TREND_WINDOW_COUNT; w++)
+    {
+      const TrendWindowStats_t * window = &channel->window[w];
+      response->printf(",\"%s\":{\"min\":%.3f,\"max\":%.3f,\"mean\":%.3f,\"slope\":%.3f,\"minutes\":%u}",
+        trend_GetWindowName((TrendWindow_t)w), window->min, window->max, window->mean, window->slope,
+        (unsigned)window->minutes);
+    }
+    response->print("}");
+  }
+  response->print("}}");
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
 }
 
 /**
-  * @brief  Called when JSON data is sent to /post endpoint. Parse JSON and update LED state
-  * @param  none
+  * @brief  Called when /env endpoint is accessed. Return all three values in
+  *         JSON response, plus rolling statistics with ?stats=1
+  * @param  request : the incoming request
   * @retval none
   */
-void handlePostLED(void) 
+void getEnv(AsyncWebServerRequest *request) 
 {
-  if (server.hasArg("plain") == false) 
+  MetricsScope timer(METRIC_HANDLER_ENV);
+  metrics_Increment(METRIC_REQUESTS);
+  LOGGER_DEBUG("Get env");
+  if (request->hasParam("stats") && request->getParam("stats")->value() == "1")
   {
-    //handle error here
+    sendStats(request);
     return;
   }
+  sendEnv(request, ENV_ALL);
+}
+
+/**
+  * @brief  Check that a JSON value is either missing or an integer within a range
+  * @param  value : JSON value to check
+  * @param  min : smallest allowed value
+  * @param  max : largest allowed value
+  * @retval true if the value is usable
+  */
+bool isOptionalInt(JsonVariantConst value, long min, long max)
+{
+  if (value.isNull())
+  {
+    return true;
+  }
+  if (!value.is<long>())
+  {
+    return false;
+  }
+  long v = value.as<long>();
+  return (v >= min && v <= max);
+}
+
+/**
+  * @brief  Check that a JSON value is either missing or a string
+  * @param  value : JSON value to check
+  * @retval true if the value is usable
+  */
+bool isOptionalString(JsonVariantConst value)
+{
+  return (value.isNull() || value.is<const char*>());
+}
+
+/**
+  * @brief  Turn an alert severity name into an AnimSeverity_t
+  * @param  value : JSON value holding the name, or nothing
+  * @param  severity : filled in with the severity (ANIM_SEVERITY_NONE if missing)
+  * @retval true if the value is missing or a known severity name
+  */
+bool parseSeverity(JsonVariantConst value, uint8_t * severity)
+{
+  static const char * const names[] = { "info", "advisory", "watch", "warning" };
+  static const uint8_t severities[] = {
+    ANIM_SEVERITY_INFO, ANIM_SEVERITY_ADVISORY, ANIM_SEVERITY_WATCH, ANIM_SEVERITY_WARNING
+  };
+
+  *severity = ANIM_SEVERITY_NONE;
+  if (value.isNull())
+  {
+    return true;
+  }
+  const char * name = value.as<const char*>();
+  if (name == NULL)
+  {
+    return false;
+  }
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+  {
+    if (strcasecmp(name, names[i]) == 0)
+    {
+      *severity = severities[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+  * @brief  Parse the optional scheduling fields of a command: "priority"
+  *         (ambient/info, advisory, watch or warning) and "duration" in
+  *         milliseconds (0 or missing = until replaced or cleared). Without
+  *         a priority, LEDs with a severity take that severity's priority
+  *         and everything else is ambient.
+  * @param  obj : object holding the fields
+  * @param  command : command whose priority and durationMs are filled in;
+  *                   its parts and led must already be set
+  * @retval true if the fields are missing or valid
+  */
+bool parseSchedule(JsonObjectConst obj, RenderCommand_t * command)
+{
+  static const char * const names[] = { "ambient", "info", "advisory", "watch", "warning" };
+  static const uint8_t priorities[] = {
+    RENDER_PRIORITY_AMBIENT, RENDER_PRIORITY_AMBIENT, RENDER_PRIORITY_ADVISORY,
+    RENDER_PRIORITY_WATCH, RENDER_PRIORITY_WARNING
+  };
+
+  if (!isOptionalString(obj["priority"]) || !isOptionalInt(obj["duration"], 0, LONG_MAX))
+  {
+    return false;
+  }
+  command->durationMs = obj["duration"];
+
+  const char * name = obj["priority"].as<const char*>();
+  if (name == NULL)
+  {
+    command->priority = RENDER_PRIORITY_AMBIENT;
+    if (command->parts & RENDER_PART_LED)
+    {
+      switch (command->led.severity)
+      {
+        case ANIM_SEVERITY_ADVISORY: command->priority = RENDER_PRIORITY_ADVISORY; break;
+        case ANIM_SEVERITY_WATCH:    command->priority = RENDER_PRIORITY_WATCH;    break;
+        case ANIM_SEVERITY_WARNING:  command->priority = RENDER_PRIORITY_WARNING;  break;
+        default: break;
+      }
+    }
+    return true;
+  }
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+  {
+    if (strcasecmp(name, names[i]) == 0)
+    {
+      command->priority = priorities[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+  * @brief  Parse and validate the LED settings in a JSON object
+  * @param  obj : object holding red, green, blue, blink, onTime, offTime and
+  *               optionally severity and fps
+  * @param  led : filled in with the validated settings
+  * @retval true if every field is valid
+  */
+bool parseLED(JsonObjectConst obj, RenderLED_t * led)
+{
+  if (obj.isNull() ||
+      !isOptionalInt(obj["red"], 0, 255) ||
+      !isOptionalInt(obj["green"], 0, 255) ||
+      !isOptionalInt(obj["blue"], 0, 255) ||
+      !isOptionalInt(obj["blink"], 0, 255) ||
+      !isOptionalInt(obj["onTime"], 0, LONG_MAX) ||
+      !isOptionalInt(obj["offTime"], 0, LONG_MAX) ||
+      !isOptionalInt(obj["fps"], 1, 100) ||
+      !parseSeverity(obj["severity"], &led->severity))
+  {
+    return false;
+  }
+
+  led->red = obj["red"];
+  led->green = obj["green"];
+  led->blue = obj["blue"];
+  led->effect = obj["blink"];
+  led->onTime = obj["onTime"];
+  led->offTime = obj["offTime"];
+  led->fps = obj["fps"];
+  return true;
+}
+
+/**
+  * @brief  Parse and validate the four lines of text in a JSON object.
+  *         A line too long to keep is rejected rather than cut short.
+  * @param  obj : object holding text1 through text4
+  * @param  lcd : filled in with a copy of the validated text
+  * @retval true if every field is valid
+  */
+bool parseLCD(JsonObjectConst obj, RenderLCD_t * lcd)
+{
+  static const char * const keys[4] = { "text1", "text2", "text3", "text4" };
+
+  if (obj.isNull())
+  {
+    return false;
+  }
+  for (int i = 0; i < 4; i++)
+  {
+    if (!isOptionalString(obj[keys[i]]))
+    {
+      return false;
+    }
+    const char * text = obj[keys[i]] | "";
+    if (strlcpy(lcd->text[i], text, RENDER_TEXT_SIZE) >= RENDER_TEXT_SIZE)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+  * @brief  Parse and validate an icon name and position in a JSON object
+  * @param  obj : object holding icon, x and y
+  * @param  icon : filled in with the validated icon request
+  * @retval true if every field is valid and the icon exists
+  */
+bool parseIcon(JsonObjectConst obj, RenderIcon_t * icon)
+{
+  if (obj.isNull() ||
+      !lcd_IsIconKnown(obj["icon"]) ||
+      !isOptionalInt(obj["x"], INT16_MIN, INT16_MAX) ||
+      !isOptionalInt(obj["y"], INT16_MIN, INT16_MAX))
+  {
+    return false;
+  }
+
+  strlcpy(icon->name, obj["icon"], RENDER_ICON_NAME_SIZE);
+  icon->x = obj["x"];
+  icon->y = obj["y"];
+  return true;
+}
+
+/**
+  * @brief  Parse a POST body in place into its arena's document, responding
+  *         with an error if there is no body or it is not valid JSON
+  * @param  request : the incoming request
+  * @retval the parsed body, or a null object after an error response
+  */
+JsonObjectConst parseBody(AsyncWebServerRequest *request)
+{
+  ArenaHeader_t *arena = getBody(request);
+  if (arena == NULL) 
+  {
+    return JsonObjectConst();
+  }
+
+  DeserializationError error;
+  {
+    MetricsScope timer(METRIC_JSON_PARSE);
+    error = arena_Parse(arena);
+  }
+  if (error == DeserializationError::NoMemory)
+  {
+    sendError(request, 413, "too many fields");
+    return JsonObjectConst();
+  }
+  if (error || !arena->doc->is<JsonObject>())
+  {
+    sendError(request, 400, "invalid JSON");
+    return JsonObjectConst();
+  }
+  return arena->doc->as<JsonObjectConst>();
+}
+
+/**
+  * @brief  Hand a validated command to the render task and respond to the
+  *         client right away. If the render task is too far behind, tell the
+  *         client to retry rather than waiting.
+  * @param  request : the incoming request
+  * @param  command : validated command to queue
+  * @retval none
+  */
+void submitCommand(AsyncWebServerRequest *request, const RenderCommand_t * command)
+{
+  if (command->parts & RENDER_PART_LED)
+  {
+    const RenderLED_t * led = &command->led;
+    LOGGER_INFO("LED Packet: Red: %u Green: %u Blue: %u Effect: %u onTime: %u offTime: %u",
+      led->red, led->green, led->blue, led->effect, (unsigned)led->onTime, (unsigned)led->offTime);
+  }
+  if (command->parts & RENDER_PART_LCD)
+  {
+    const RenderLCD_t * lcd = &command->lcd;
+    LOGGER_INFO("LCD Text Packet: text1: %s text2: %s text3: %s text4: %s",
+      lcd->text[0], lcd->text[1], lcd->text[2], lcd->text[3]);
+  }
+  if (command->parts & RENDER_PART_ICON)
+  {
+    LOGGER_INFO("Icon: %s at %d, %d", command->icon.name, command->icon.x, command->icon.y);
+  }
+  if (command->parts & RENDER_PART_CLEAR)
+  {
+    LOGGER_INFO("Clear priority %u", command->priority);
+  }
 
-  String body = server.arg("plain");
-  Serial.println(body);
-  deserializeJson(jsonDocument, body);
-  
-  // Get RGB components
-  int red = jsonDocument["red"];
-  int green = jsonDocument["green"];
-  int blue = jsonDocument["blue"];
-  int effect = jsonDocument["blink"];
-  int onTime = jsonDocument["onTime"];
-  int offTime = jsonDocument["offTime"];
-
-  Serial.println("LED Packet:");
-  Serial.print("Red: ");
-  Serial.print(red);
-  Serial.print(" Green: ");
-  Serial.print(green);
-  Serial.print(" Blue: ");
-  Serial.print(blue);
-  Serial.print(" Effect: ");
-  Serial.print(effect);
-  Serial.print(" onTime: ");
-  Serial.print(onTime);
-  Serial.print(" offTime: ");
-  Serial.println(offTime);
-
-  led_changeEffect(red, green, blue, effect, onTime, offTime);
+  if (!render_Submit(command))
+  {
+    metrics_Increment(METRIC_ERRORS);
+    AsyncWebServerResponse *response = request->beginResponse(429, "application/json", "{\"error\":\"busy\"}");
+    response->addHeader("Retry-After", "1");
+    request->send(response);
+    return;
+  }
 
   // Respond to the client
-  server.send(200, "application/json", "{}");
+  request->send(200, "application/json", "{}");
 }
 
 /**
-  * @brief  Called when data POSTed to /lcd endpoint. Parse JSON and update screen with text.
-  * @param  none
+  * @brief  Called when JSON data is sent to /post endpoint. Parse JSON and update LED state
+  * @param  request : the incoming request
   * @retval none
   */
-void handlePostLCD(void) 
+void handlePostLED(AsyncWebServerRequest *request) 
 {
-  if (server.hasArg("plain") == false) 
+  RenderCommand_t command;
+  MetricsScope timer(METRIC_HANDLER_LED);
+  metrics_Increment(METRIC_REQUESTS);
+
+  JsonObjectConst body = parseBody(request);
+  if (body.isNull())
   {
-    //handle error here
+    return;
+  }
+  command.parts = RENDER_PART_LED;
+  if (!parseLED(body, &command.led))
+  {
+    sendError(request, 400, "invalid led");
+    return;
+  }
+  if (!parseSchedule(body, &command))
+  {
+    sendError(request, 400, "invalid priority");
     return;
   }
 
-  String body = server.arg("plain");
-  Serial.println(body);
-  deserializeJson(jsonDocument, body);
-  
-  // Get RGB components
-  const char* text1 = jsonDocument["text1"];
-  const char* text2 = jsonDocument["text2"];
-  const char* text3 = jsonDocument["text3"];
-  const char* text4 = jsonDocument["text4"];
-
-  Serial.println("LCD Text Packet:");
-  Serial.print("text1: ");
-  Serial.println(text1);
-  Serial.print("text2: ");
-  Serial.println(text2);
-  Serial.print("text3: ");
-  Serial.println(text3);
-  Serial.print("text4: ");
-  Serial.println(text4);
-
-  // Actually print the lines of text out on the LCD
-  lcd_printTextLines(text1, text2, text3, text4);
+  submitCommand(request, &command);
+}
 
-  // Respond to the client
-  server.send(200, "application/json", "{}");
+/**
+  * @brief  Called when data POSTed to /lcd endpoint. Parse JSON and update screen with text.
+  * @param  request : the incoming request
+  * @retval none
+  */
+void handlePostLCD(AsyncWebServerRequest *request) 
+{
+  RenderCommand_t command;
+  MetricsScope timer(METRIC_HANDLER_LCD);
+  metrics_Increment(METRIC_REQUESTS);
+
+  JsonObjectConst body = parseBody(request);
+  if (body.isNull())
+  {
+    return;
+  }
+  command.parts = RENDER_PART_LCD;
+  if (!parseLCD(body, &command.lcd))
+  {
+    sendError(request, 400, "invalid lcd");
+    return;
+  }
+  if (!parseSchedule(body, &command))
+  {
+    sendError(request, 400, "invalid priority");
+    return;
+  }
+
+  submitCommand(request, &command);
 }
 
 /**
   * @brief  Called when data POSTed to /icon endpoint. Parse JSON and draw icon on screen
-  * @param  none
+  * @param  request : the incoming request
   * @retval none
   */
-void handlePostIcon(void) 
+void handlePostIcon(AsyncWebServerRequest *request) 
 {
-  if (server.hasArg("plain") == false) 
+  RenderCommand_t command;
+  MetricsScope timer(METRIC_HANDLER_ICON);
+  metrics_Increment(METRIC_REQUESTS);
+
+  JsonObjectConst body = parseBody(request);
+  if (body.isNull())
+  {
+    return;
+  }
+  command.parts = RENDER_PART_ICON;
+  if (!parseIcon(body, &command.icon))
+  {
+    sendError(request, 400, "invalid icon");
+    return;
+  }
+  if (!parseSchedule(body, &command))
   {
-    //handle error here
+    sendError(request, 400, "invalid priority");
     return;
   }
 
-  String body = server.arg("plain");
-  Serial.println(body);
-  deserializeJson(jsonDocument, body);
-  
-  // Get RGB components
-  const char* iconName = jsonDocument["icon"];
-  int xCoord = jsonDocument["x"];
-  int yCoord = jsonDocument["y"];
- 
-  /// TODO: Actually draw the icon 
-  // Use iconName, x and y coordinates to draw a grpahic on the screen
-//  tft.pushImage(1, 60, 64, 64, a02d_smoke_64);
+  submitCommand(request, &command);
+}
 
-  // Respond to the client
-  server.send(200, "application/json", "{}");
+/**
+  * @brief  Called when data POSTed to /state endpoint. The body holds optional
+  *         "lcd", "led" and "icon" sections, each with the same fields as the
+  *         matching endpoint. Every section present is validated before any
+  *         of them is queued, and they are queued as one command, so the
+  *         screen and LEDs never show half of an update. "priority" and
+  *         "duration" schedule the update, and "clear": true removes all
+  *         content of that priority instead.
+  * @param  request : the incoming request
+  * @retval none
+  */
+void handlePostState(AsyncWebServerRequest *request)
+{
+  RenderCommand_t command;
+  MetricsScope timer(METRIC_HANDLER_STATE);
+  metrics_Increment(METRIC_REQUESTS);
+
+  JsonObjectConst body = parseBody(request);
+  if (body.isNull())
+  {
+    return;
+  }
+
+  command.parts = 0;
+  if (!body["lcd"].isNull())
+  {
+    command.parts |= RENDER_PART_LCD;
+    if (!parseLCD(body["lcd"].as<JsonObjectConst>(), &command.lcd))
+    {
+      sendError(request, 400, "invalid lcd");
+      return;
+    }
+  }
+  if (!body["led"].isNull())
+  {
+    command.parts |= RENDER_PART_LED;
+    if (!parseLED(body["led"].as<JsonObjectConst>(), &command.led))
+    {
+      sendError(request, 400, "invalid led");
+      return;
+    }
+  }
+  if (!body["icon"].isNull())
+  {
+    command.parts |= RENDER_PART_ICON;
+    if (!parseIcon(body["icon"].as<JsonObjectConst>(), &command.icon))
+    {
+      sendError(request, 400, "invalid icon");
+      return;
+    }
+  }
+  if (body["clear"] | false)
+  {
+    command.parts = RENDER_PART_CLEAR;
+  }
+  if (command.parts == 0)
+  {
+    sendError(request, 400, "no lcd, led, icon or clear");
+    return;
+  }
+  if (!parseSchedule(body, &command))
+  {
+    sendError(request, 400, "invalid priority");
+    return;
+  }
+
+  submitCommand(request, &command);
+}
+
+/**
+  * @brief  Read an optional integer query parameter
+  * @param  request : the incoming request
+  * @param  name : parameter name
+  * @param  value : set to the parameter if present, otherwise left alone
+  * @retval false if the parameter is present but not an integer
+  */
+bool getIntParam(AsyncWebServerRequest *request, const char * name, int64_t * value)
+{
+  if (!request->hasParam(name))
+  {
+    return true;
+  }
+
+  const char * text = request->getParam(name)->value().c_str();
+  char * end;
+  long long parsed = strtoll(text, &end, 10);
+  if (end == text || *end != '\0')
+  {
+    return false;
+  }
+  *value = parsed;
+  return true;
+}
+
+/**
+  * @brief  Turn a /history time parameter into Unix seconds between 0 and
+  *         now, so scaling it to milliseconds can't overflow
+  * @param  value : Unix seconds, or seconds before now if negative
+  * @param  now : current time in Unix seconds
+  * @retval the time, clamped to [0, now]
+  */
+int64_t clampTime(int64_t value, int64_t now)
+{
+  if (value < 0)
+  {
+    value = (value < -now) ? 0 : now + value;
+  }
+  return (value > now) ? now : value;
+}
+
+/**
+  * @brief  Chunk callback for /history. Writes as much of the response as
+  *         fits, one averaged bucket at a time, so the whole response is
+  *         never held in memory.
+  * @param  stream : state of this response
+  * @param  buffer : where to write the next chunk
+  * @param  maxLen : room in buffer
+  * @retval bytes written, 0 at the end of the response
+  */
+size_t fillHistory(HistoryStream_t * stream, uint8_t * buffer, size_t maxLen)
+{
+  size_t used = 0;
+
+  while (used < maxLen)
+  {
+    if (stream->sent == stream->length)
+    {
+      HistorySample_t sample;
+
+      if (stream->done)
+      {
+        break;
+      }
+      if (history_NextBucket(&stream->query, &sample))
+      {
+        stream->length = snprintf(stream->line, sizeof(stream->line),
+          "%s{\"t\":%lld,\"temperature\":%.2f,\"humidity\":%.2f,\"pressure\":%.3f}",
+          stream->first ? "" : ",", (long long)(sample.timeMs / 1000),
+          sample.temperature / 100.0, sample.humidity / 100.0, sample.pressure / 1000.0);
+        stream->first = false;
+      }
+      else
+      {
+        stream->length = snprintf(stream->line, sizeof(stream->line), "]}");
+        stream->done = true;
+      }
+      stream->sent = 0;
+    }
+
+    size_t count = min(maxLen - used, stream->length - stream->sent);
+    memcpy(buffer + used, stream->line + stream->sent, count);
+    used += count;
+    stream->sent += count;
+  }
+  return used;
+}
+
+/**
+  * @brief  Called when /history endpoint is accessed. Streams the stored
+  *         samples between from and to (Unix seconds, or seconds before now
+  *         if negative, both clamped to [0, now]), averaged over buckets of
+  *         step seconds. Defaults: all stored samples, 60 s buckets.
+  * @param  request : the incoming request
+  * @retval none
+  */
+void getHistory(AsyncWebServerRequest *request)
+{
+  MetricsScope timer(METRIC_HANDLER_HISTORY);
+  metrics_Increment(METRIC_REQUESTS);
+
+  int64_t now = history_Now() / 1000;
+  int64_t from = now;
+  int64_t to = now;
+  int64_t step = 60;
+  int64_t oldestMs;
+
+  if (history_GetOldest(&oldestMs))
+  {
+    from = oldestMs / 1000;
+  }
+  if (!getIntParam(request, "from", &from) ||
+      !getIntParam(request, "to", &to) ||
+      !getIntParam(request, "step", &step))
+  {
+    sendError(request, 400, "invalid parameter");
+    return;
+  }
+  from = clampTime(from, now);
+  to = clampTime(to, now);
+  if (step < 1 || to < from)
+  {
+    sendError(request, 400, "invalid range");
+    return;
+  }
+  // One bucket for the whole range is as coarse as it gets
+  if (step > to - from + 1)
+  {
+    step = to - from + 1;
+  }
+
+  std::shared_ptr<HistoryStream_t> stream(new (std::nothrow) HistoryStream_t);
+  if (!stream)
+  {
+    sendError(request, 503, "out of memory");
+    return;
+  }
+  history_BeginQuery(&stream->query, from * 1000, to * 1000 + 999, step * 1000);
+  stream->length = snprintf(stream->line, sizeof(stream->line),
+    "{\"from\":%lld,\"to\":%lld,\"step\":%lld,\"samples\":[",
+    (long long)from, (long long)to, (long long)step);
+  stream->sent = 0;
+  stream->first = true;
+  stream->done = false;
+
+  // The response owns the stream state and frees it when the connection closes
+  AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+    [stream](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+    {
+      return fillHistory(stream.get(), buffer, maxLen);
+    });
+  request->send(response);
+}
+
+/**
+  * @brief  Chunk callback for /metrics. Writes as much of the response as
+  *         fits, one line at a time.
+  * @param  stream : state of this response
+  * @param  buffer : where to write the next chunk
+  * @param  maxLen : room in buffer
+  * @retval bytes written, 0 at the end of the response
+  */
+size_t fillMetrics(MetricsStream_t * stream, uint8_t * buffer, size_t maxLen)
+{
+  size_t used = 0;
+
+  while (used < maxLen)
+  {
+    if (stream->sent == stream->length)
+    {
+      stream->length = metrics_NextLine(&stream->cursor, stream->line, sizeof(stream->line));
+      stream->sent = 0;
+      if (stream->length == 0)
+      {
+        break;
+      }
+    }
+
+    size_t count = min(maxLen - used, stream->length - stream->sent);
+    memcpy(buffer + used, stream->line + stream->sent, count);
+    used += count;
+    stream->sent += count;
+  }
+  return used;
+}
+
+/**
+  * @brief  Called when /metrics endpoint is accessed. Streams latency
+  *         histograms and counters in Prometheus text format, so the
+  *         text (tens of KB) is never held in memory at once
+  * @param  request : the incoming request
+  * @retval none
+  */
+void getMetrics(AsyncWebServerRequest *request)
+{
+  metrics_Increment(METRIC_REQUESTS);
+
+  std::shared_ptr<MetricsStream_t> stream(new (std::nothrow) MetricsStream_t);
+  if (!stream)
+  {
+    sendError(request, 503, "out of memory");
+    return;
+  }
+  metrics_Begin(&stream->cursor);
+  stream->length = 0;
+  stream->sent = 0;
+
+  // The response owns the stream state and frees it when the connection closes
+  AsyncWebServerResponse *response = request->beginChunkedResponse("text/plain; version=0.0.4",
+    [stream](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+    {
+      return fillMetrics(stream.get(), buffer, maxLen);
+    });
+  request->send(response);
+}
+
+/**
+  * @brief  Called when /debug/boot endpoint is accessed. Return when each
+  *         boot stage was reached, in microseconds since reset:
+  *         {"resetReason": n, "stages": {"setup": us, ..., "first_request": us}}
+  *         A stage not reached yet is null.
+  * @param  request : the incoming request
+  * @retval none
+  */
+void getBoot(AsyncWebServerRequest *request)
+{
+  metrics_Increment(METRIC_REQUESTS);
+
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  response->printf("{\"resetReason\":%d,\"stages\":{", (int)esp_reset_reason());
+  for (int stage = 0; stage < BOOT_STAGE_COUNT; stage++)
+  {
+    int64_t us = boot_GetStageUs((BootStage_t)stage);
+    response->printf("%s\"%s\":", stage ? "," : "", boot_GetStageName((BootStage_t)stage));
+    if (us == 0)
+    {
+      response->print("null");
+    }
+    else
+    {
+      response->printf("%lld", (long long)us);
+    }
+  }
+  response->print("}}");
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
+/**
+  * @brief  Chunk callback for /debug/tasks. Writes as much of the response
+  *         as fits, one task at a time.
+  * @param  stream : state of this response
+  * @param  buffer : where to write the next chunk
+  * @param  maxLen : room in buffer
+  * @retval bytes written, 0 at the end of the response
+  */
+size_t fillTasks(TasksStream_t * stream, uint8_t * buffer, size_t maxLen)
+{
+  size_t used = 0;
+
+  while (used < maxLen)
+  {
+    if (stream->sent == stream->length)
+    {
+      TaskStatsRow_t row;
+
+      if (stream->done)
+      {
+        break;
+      }
+      if (taskstats_Next(&stream->query, &row))
+      {
+        char core[8] = "null";
+        char cpu[TASKSTATS_WINDOW_COUNT][12];
+
+        if (row.core >= 0)
+        {
+          snprintf(core, sizeof(core), "%d", row.core);
+        }
+        for (int w = 0; w < TASKSTATS_WINDOW_COUNT; w++)
+        {
+          if (row.cpu[w] < 0)
+          {
+            strcpy(cpu[w], "null");
+          }
+          else
+          {
+            snprintf(cpu[w], sizeof(cpu[w]), "%.2f", row.cpu[w]);
+          }
+        }
+        stream->length = snprintf(stream->line, sizeof(stream->line),
+          "%s{\"name\":\"%s\",\"state\":\"%s\",\"priority\":%u,\"core\":%s,\"stackFree\":%u,"
+          "\"cpu\":{\"%s\":%s,\"%s\":%s}}",
+          stream->first ? "" : ",", row.name, row.state, (unsigned)row.priority, core,
+          (unsigned)row.stackFree, taskstats_GetWindowName(0), cpu[0], taskstats_GetWindowName(1), cpu[1]);
+        stream->first = false;
+      }
+      else
+      {
+        stream->length = snprintf(stream->line, sizeof(stream->line), "]}");
+        stream->done = true;
+      }
+      stream->sent = 0;
+    }
+
+    size_t count = min(maxLen - used, stream->length - stream->sent);
+    memcpy(buffer + used, stream->line + stream->sent, count);
+    used += count;
+    stream->sent += count;
+  }
+  return used;
+}
+
+/**
+  * @brief  Called when /debug/tasks endpoint is accessed. Streams heap
+  *         statistics and, for every task, its state, priority, core,
+  *         unused stack and share of one core over each window:
+  *         {"heap": {"free", "minFree", "largestBlock", "fragmentation"},
+  *          "windows": {"5s": ms, "60s": ms}, "tasks": [{"name", "state",
+  *          "priority", "core", "stackFree", "cpu": {"5s", "60s"}}, ...]}
+  * @param  request : the incoming request
+  * @retval none
+  */
+void getTasks(AsyncWebServerRequest *request)
+{
+  TaskHeapStats_t heap;
+
+  metrics_Increment(METRIC_REQUESTS);
+
+  std::shared_ptr<TasksStream_t> stream(new (std::nothrow) TasksStream_t);
+  if (!stream)
+  {
+    sendError(request, 503, "out of memory");
+    return;
+  }
+  if (!taskstats_Begin(&stream->query))
+  {
+    sendError(request, 503, "too many tasks");
+    return;
+  }
+  taskstats_GetHeap(&heap);
+  stream->length = snprintf(stream->line, sizeof(stream->line),
+    "{\"heap\":{\"free\":%u,\"minFree\":%u,\"largestBlock\":%u,\"fragmentation\":%.3f},"
+    "\"windows\":{\"%s\":%u,\"%s\":%u},\"tasks\":[",
+    (unsigned)heap.free, (unsigned)heap.minFree, (unsigned)heap.largestBlock, heap.fragmentation,
+    taskstats_GetWindowName(0), (unsigned)taskstats_GetWindowMs(&stream->query, 0),
+    taskstats_GetWindowName(1), (unsigned)taskstats_GetWindowMs(&stream->query, 1));
+  stream->sent = 0;
+  stream->first = true;
+  stream->done = false;
+
+  // The response owns the stream state and frees it when the connection closes
+  AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+    [stream](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+    {
+      return fillTasks(stream.get(), buffer, maxLen);
+    });
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
+/**
+  * @brief  Called when /debug/wifi endpoint is accessed. Return the link
+  *         and the connection history since boot
+  * @param  request : the incoming request
+  * @retval none
+  */
+void getWifi(AsyncWebServerRequest *request)
+{
+  WifiStats_t stats;
+
+  metrics_Increment(METRIC_REQUESTS);
+  wifimgr_GetStats(&stats);
+
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  response->printf("{\"connected\":%s,\"bssid\":\"%s\",\"channel\":%d,\"rssi\":%d,\"ip\":\"%s\",",
+    stats.connected ? "true" : "false", WiFi.BSSIDstr().c_str(), (int)WiFi.channel(), (int)WiFi.RSSI(),
+    WiFi.localIP().toString().c_str());
+  response->printf("\"attempts\":%u,\"fastConnects\":%u,\"disconnects\":%u,\"lastReason\":%u,",
+    (unsigned)stats.attempts, (unsigned)stats.fastConnects, (unsigned)stats.disconnects,
+    (unsigned)stats.lastReason);
+  response->printf("\"reconnects\":%u,\"lastReconnectMs\":%u,\"maxReconnectMs\":%u,\"meanReconnectMs\":%u}",
+    (unsigned)stats.reconnects, (unsigned)stats.lastReconnectMs, (unsigned)stats.maxReconnectMs,
+    (unsigned)(stats.reconnects ? stats.totalReconnectMs / stats.reconnects : 0));
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
+/**
+  * @brief  Called for any request that does not match a registered endpoint
+  * @param  request : the incoming request
+  * @retval none
+  */
+void handleNotFound(AsyncWebServerRequest *request)
+{
+  metrics_Increment(METRIC_REQUESTS);
+  sendError(request, 404, "not found");
 }
 
 /* Public functions ---------------------------------------------------------*/
@@ -280,13 +1224,22 @@ void handlePostIcon(void)
 // See header file for documentation block
 void handlers_Init(void) 
 {
+  server.addHandler(&FirstRequestMarker);
+  server.addHandler(&EnvHeaders);
   server.on("/temperature", getTemperature);
   server.on("/pressure", getPressure);
   server.on("/humidity", getHumidity);
   server.on("/env", getEnv);
-  server.on("/led", HTTP_POST, handlePostLED);
-  server.on("/lcd", HTTP_POST, handlePostLCD);
-  server.on("/icon", HTTP_POST, handlePostIcon);
+  server.on("/led", HTTP_POST, handlePostLED, NULL, collectBody<LedArena_t, LedArenas>);
+  server.on("/lcd", HTTP_POST, handlePostLCD, NULL, collectBody<LcdArena_t, LcdArenas>);
+  server.on("/icon", HTTP_POST, handlePostIcon, NULL, collectBody<IconArena_t, IconArenas>);
+  server.on("/state", HTTP_POST, handlePostState, NULL, collectBody<StateArena_t, StateArenas>);
+  server.on("/history", HTTP_GET, getHistory);
+  server.on("/metrics", HTTP_GET, getMetrics);
+  server.on("/debug/boot", HTTP_GET, getBoot);
+  server.on("/debug/wifi", HTTP_GET, getWifi);
+  server.on("/debug/tasks", HTTP_GET, getTasks);
+  server.onNotFound(handleNotFound);
  
   // start server
   server.begin();
@@ -295,5 +1248,8 @@ void handlers_Init(void)
 // See header file for documentation block
 void handlers_Run(void)
 {
-  server.handleClient();
+  metrics_Increment(METRIC_LOOPS);
+
+  // Requests are served from the AsyncTCP task, so just let the loop task sleep
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
 }
\ No newline at end of file
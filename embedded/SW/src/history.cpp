@@ -0,0 +1,366 @@
+/**
+  ******************************************************************************
+  * @file    history.cpp
+  * @author  Brian Schmalz
+  * @brief   In RAM ring buffer of sensor samples
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <sys/time.h>
+#include <stddef.h>
+#include "history.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/// NOTE: Blocks form a ring. Block ids count up forever and block n lives in
+/// slot n % BlockCount, so a reader can tell when the block it wanted has
+/// been overwritten. The sensor task appends under BlockLock, and readers hold
+/// BlockLock only while copying one block out, so neither waits long.
+static HistoryBlock_t * Blocks;
+static uint32_t BlockCount;
+static portMUX_TYPE BlockLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Id of the block being appended to, valid once HaveSamples is set
+static uint32_t NewestBlock;
+static bool HaveSamples;
+
+// Time between samples
+static uint32_t SamplePeriod;
+
+// Last sample stored, for working out the next difference (sensor task only)
+static int32_t LastValue[HISTORY_CHANNELS];
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Id of the oldest block still in the ring. Call with BlockLock held.
+  * @retval block id
+  */
+static uint32_t oldestId(void)
+{
+  return (NewestBlock >= BlockCount) ? NewestBlock - BlockCount + 1 : 0;
+}
+
+/**
+  * @brief  Time of the oldest sample held in RAM
+  * @param  timeMs : set to the time if there is one
+  * @retval false if RAM holds no samples
+  */
+static bool ramOldest(int64_t * timeMs)
+{
+  bool found;
+
+  portENTER_CRITICAL(&BlockLock);
+  found = HaveSamples;
+  if (found)
+  {
+    *timeMs = Blocks[oldestId() % BlockCount].baseMs;
+  }
+  portEXIT_CRITICAL(&BlockLock);
+  return found;
+}
+
+/**
+  * @brief  Copy the next block that overlaps the query range
+  * @param  query : query to load the block into
+  * @retval false if there are no more blocks
+  */
+static bool loadBlock(HistoryQuery_t * query)
+{
+  for (;;)
+  {
+    bool overlaps;
+
+    portENTER_CRITICAL(&BlockLock);
+    if (!HaveSamples || query->block > NewestBlock)
+    {
+      portEXIT_CRITICAL(&BlockLock);
+      return false;
+    }
+    if (query->block < oldestId())
+    {
+      query->block = oldestId();
+    }
+
+    const HistoryBlock_t * block = &Blocks[query->block % BlockCount];
+    int64_t lastMs = block->baseMs + (int64_t)(block->count - 1) * SamplePeriod;
+    overlaps = (lastMs >= query->fromMs && block->baseMs <= query->toMs);
+    if (overlaps)
+    {
+      // Only the differences in use
+      memcpy(&query->copy, block,
+        offsetof(HistoryBlock_t, delta) + (block->count - 1) * sizeof(block->delta[0]));
+    }
+    portEXIT_CRITICAL(&BlockLock);
+
+    query->block++;
+    if (overlaps)
+    {
+      query->index = 0;
+      query->loaded = true;
+      return true;
+    }
+  }
+}
+
+/**
+  * @brief  Get the next stored sample of a query, in the order stored
+  * @param  query : query to read from
+  * @param  sample : filled in with the sample
+  * @retval false if there are no more samples
+  */
+static bool nextSample(HistoryQuery_t * query, HistorySample_t * sample)
+{
+  if (query->inLog)
+  {
+    if (tslog_Next(&query->log, sample))
+    {
+      return true;
+    }
+    query->inLog = false;
+  }
+
+  if (!query->loaded || query->index >= query->copy.count)
+  {
+    if (!loadBlock(query))
+    {
+      return false;
+    }
+  }
+
+  for (int c = 0; c < HISTORY_CHANNELS; c++)
+  {
+    if (query->index == 0)
+    {
+      query->value[c] = query->copy.base[c];
+    }
+    else
+    {
+      query->value[c] += query->copy.delta[query->index - 1][c];
+    }
+  }
+  sample->timeMs = query->copy.baseMs + (int64_t)query->index * SamplePeriod;
+  sample->temperature = query->value[0];
+  sample->humidity = query->value[1];
+  sample->pressure = query->value[2];
+  query->index++;
+  return true;
+}
+
+/**
+  * @brief  Fill in the average of the bucket being built
+  * @param  query : query with at least one sample in the bucket
+  * @param  sample : filled in with the bucket
+  * @retval none
+  */
+static void averageBucket(const HistoryQuery_t * query, HistorySample_t * sample)
+{
+  sample->timeMs = query->bucketMs;
+  sample->temperature = query->sum[0] / (int64_t)query->n;
+  sample->humidity = query->sum[1] / (int64_t)query->n;
+  sample->pressure = query->sum[2] / (int64_t)query->n;
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+bool history_Init(uint32_t periodMs)
+{
+  SamplePeriod = (periodMs > 0) ? periodMs : 1;
+  tslog_Init();
+
+  BlockCount = HISTORY_BUDGET / sizeof(HistoryBlock_t);
+  if (BlockCount == 0)
+  {
+    return false;
+  }
+
+  // Use PSRAM when the board has it, otherwise the normal heap
+  Blocks = (HistoryBlock_t *)heap_caps_malloc(BlockCount * sizeof(HistoryBlock_t), MALLOC_CAP_SPIRAM);
+  if (Blocks == NULL)
+  {
+    Blocks = (HistoryBlock_t *)malloc(BlockCount * sizeof(HistoryBlock_t));
+  }
+  return (Blocks != NULL);
+}
+
+// See header file for documentation block
+int64_t history_Now(void)
+{
+  struct timeval now;
+
+  gettimeofday(&now, NULL);
+  return (int64_t)now.tv_sec * 1000 + now.tv_usec / 1000;
+}
+
+// See header file for documentation block
+void history_Add(const HistorySample_t * sample)
+{
+  int32_t value[HISTORY_CHANNELS] = { sample->temperature, sample->humidity, sample->pressure };
+  int64_t timeMs = sample->timeMs;
+  bool fresh = !HaveSamples;
+
+  tslog_Add(sample);
+  if (Blocks == NULL)
+  {
+    return;
+  }
+
+  // Start a new block if this one is full, the sample is off schedule (a
+  // failed read or a clock change) or a difference will not fit in 16 bits
+  HistoryBlock_t * block = &Blocks[NewestBlock % BlockCount];
+  if (!fresh)
+  {
+    int64_t expected = block->baseMs + (int64_t)block->count * SamplePeriod;
+    fresh = (block->count >= HISTORY_BLOCK_SAMPLES) || (llabs(timeMs - expected) > SamplePeriod / 2);
+    for (int c = 0; c < HISTORY_CHANNELS; c++)
+    {
+      int32_t delta = value[c] - LastValue[c];
+      fresh = fresh || (delta < INT16_MIN) || (delta > INT16_MAX);
+    }
+  }
+
+  portENTER_CRITICAL(&BlockLock);
+  if (fresh)
+  {
+    if (HaveSamples)
+    {
+      NewestBlock++;
+    }
+    block = &Blocks[NewestBlock % BlockCount];
+    block->id = NewestBlock;
+    block->baseMs = timeMs;
+    block->count = 1;
+    memcpy(block->base, value, sizeof(block->base));
+    HaveSamples = true;
+  }
+  else
+  {
+    for (int c = 0; c < HISTORY_CHANNELS; c++)
+    {
+      block->delta[block->count - 1][c] = (int16_t)(value[c] - LastValue[c]);
+    }
+    block->count++;
+  }
+  portEXIT_CRITICAL(&BlockLock);
+
+  memcpy(LastValue, value, sizeof(LastValue));
+}
+
+// See header file for documentation block
+void history_BeginQuery(HistoryQuery_t * query, int64_t fromMs, int64_t toMs, int64_t stepMs)
+{
+  int64_t ramOldestMs = INT64_MAX;
+
+  query->fromMs = fromMs;
+  query->toMs = toMs;
+  query->stepMs = (stepMs > 0) ? stepMs : 1;
+
+  // The log covers what is older than RAM, so no sample comes out twice
+  ramOldest(&ramOldestMs);
+  tslog_BeginRead(&query->log, fromMs, min(toMs, ramOldestMs - 1));
+  query->inLog = true;
+  query->block = 0;
+  query->index = 0;
+  query->loaded = false;
+  query->n = 0;
+}
+
+// See header file for documentation block
+bool history_NextBucket(HistoryQuery_t * query, HistorySample_t * sample)
+{
+  HistorySample_t next;
+
+  while (nextSample(query, &next))
+  {
+    if (next.timeMs < query->fromMs || next.timeMs > query->toMs)
+    {
+      continue;
+    }
+
+    int64_t bucketMs = query->fromMs + (next.timeMs - query->fromMs) / query->stepMs * query->stepMs;
+    bool done = (query->n > 0 && bucketMs != query->bucketMs);
+    if (done)
+    {
+      averageBucket(query, sample);
+    }
+    if (done || query->n == 0)
+    {
+      query->bucketMs = bucketMs;
+      query->sum[0] = 0;
+      query->sum[1] = 0;
+      query->sum[2] = 0;
+      query->n = 0;
+    }
+    query->sum[0] += next.temperature;
+    query->sum[1] += next.humidity;
+    query->sum[2] += next.pressure;
+    query->n++;
+    if (done)
+    {
+      return true;
+    }
+  }
+
+  // Flush the last bucket
+  if (query->n > 0)
+  {
+    averageBucket(query, sample);
+    query->n = 0;
+    return true;
+  }
+  return false;
+}
+
+// See header file for documentation block
+bool history_GetOldest(int64_t * timeMs)
+{
+  int64_t logMs;
+  bool found = ramOldest(timeMs);
+
+  if (tslog_GetOldest(&logMs) && (!found || logMs < *timeMs))
+  {
+    *timeMs = logMs;
+    found = true;
+  }
+  return found;
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+/**
+  ******************************************************************************
+  * @file    icons.cpp
+  * @author  Brian Schmalz
+  * @brief   Compressed icon store and row by row decoder
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "icons.h"
+#include "icontable.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+// Run types, in the top two bits of each run's first byte. The low six bits
+// hold the run length minus one. Runs never cross rows.
+#define ICON_RUN_MASK         0xC0
+#define ICON_RUN_TRANSPARENT  0x00    // Transparent pixels
+#define ICON_RUN_REPEAT       0x40    // One color follows, repeated
+#define ICON_RUN_LITERAL      0x80    // One color per pixel follows
+#define ICON_RUN_LENGTH       0x3F
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+// Encoded data of all icons, generated into icondata.cpp by
+// scripts/icon_convert.py. IconAssets (icontable.h) says where each icon is.
+extern const uint8_t IconData[];
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Read a little endian RGB565 color from icon data
+  * @param  data : First byte of the color
+  * @retval The color
+  */
+static inline uint16_t readColor(const uint8_t * data)
+{
+  return data[0] | (data[1] << 8);
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+const IconAsset_t * icons_Find(const char * name)
+{
+  if (name == NULL)
+  {
+    return NULL;
+  }
+
+  int index = icontable_Find(name);
+  return (index >= 0) ? &IconAssets[index] : NULL;
+}
+
+// See header file for documentation block
+void icons_BeginDecode(IconDecoder_t * decoder, const IconAsset_t * asset)
+{
+  decoder->asset = asset;
+  decoder->offset = 0;
+  decoder->row = 0;
+}
+
+// See header file for documentation block
+bool icons_DecodeRow(IconDecoder_t * decoder, uint16_t * line)
+{
+  const IconAsset_t * asset = decoder->asset;
+  const uint8_t * data = &IconData[asset->offset];
+  uint32_t offset = decoder->offset;
+  int x = 0;
+
+  if (asset->encoding != ICON_ENCODING_RLE || decoder->row >= asset->height)
+  {
+    return false;
+  }
+
+  while (x < asset->width)
+  {
+    if (offset >= asset->size)
+    {
+      return false;
+    }
+    uint8_t run = data[offset++];
+    int count = (run & ICON_RUN_LENGTH) + 1;
+    if (x + count > asset->width)
+    {
+      return false;
+    }
+
+    switch (run & ICON_RUN_MASK)
+    {
+      case ICON_RUN_TRANSPARENT:
+        for (int i = 0; i < count; i++)
+        {
+          line[x++] = ICON_TRANSPARENT;
+        }
+        break;
+
+      case ICON_RUN_REPEAT:
+      {
+        if (offset + 2 > asset->size)
+        {
+          return false;
+        }
+        uint16_t color = readColor(&data[offset]);
+        offset += 2;
+        for (int i = 0; i < count; i++)
+        {
+          line[x++] = color;
+        }
+        break;
+      }
+
+      case ICON_RUN_LITERAL:
+        if (offset + 2 * count > asset->size)
+        {
+          return false;
+        }
+        for (int i = 0; i < count; i++)
+        {
+          line[x++] = readColor(&data[offset]);
+          offset += 2;
+        }
+        break;
+
+      default:
+        return false;
+    }
+  }
+
+  decoder->offset = offset;
+  decoder->row++;
+  return true;
+}
\ No newline at end of file
@@ -34,18 +34,44 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <Arduino.h>
-#include <WiFi.h>
 #include <FreeRTOS.h>
 #include <TFT_eSPI.h> // Graphics and font library for ST7735 driver chip
 #include <SPI.h>
+#include "logger.h"
+#include "metrics.h"
+#include "icons.h"
+#include "rastercache.h"
 
+/* Private define ------------------------------------------------------------*/
+
+// Number of text lines, and the longest line we remember for comparison
+#define LCD_LINE_COUNT        4
+#define LCD_LINE_TEXT_SIZE    64
 
-// Include graphic/icon array header files here
-#include "a02d_smoke_64.h"
+// Layout of the text lines (font 4 is 26 pixels high)
+#define LINE_FONT             4
+#define LINE_X                1
+#define LINE_HEIGHT           36
+
+// Icons drawn since the last text update that we can clear individually
+#define LCD_MAX_ICON_RECTS    4
 
 /* Private typedef -----------------------------------------------------------*/
 
-/* Private define ------------------------------------------------------------*/
+// What is currently drawn for one line of text
+typedef struct {
+  char text[LCD_LINE_TEXT_SIZE];
+  int16_t width;                // Width in pixels of the text on screen
+  bool valid;                   // false if the line must be redrawn
+} LineState_t;
+
+// Area of the screen covered by an icon
+typedef struct {
+  int16_t x;
+  int16_t y;
+  int16_t width;
+  int16_t height;
+} IconRect_t;
 
 /* Private macro -------------------------------------------------------------*/
 
@@ -53,6 +79,50 @@
 
 TFT_eSPI tft = TFT_eSPI();  // Invoke library, pins defined in User_Setup.h
 
+// What the text lines on the screen currently show
+LineState_t Lines[LCD_LINE_COUNT];
+
+// false when something other than the text lines (the boot message) has
+// been drawn, so the next text update clears the whole screen
+bool ScreenValid = false;
+
+// Icons drawn on top of the text since the last text update. IconOverflow
+// is set when there were more than we can remember.
+IconRect_t IconRects[LCD_MAX_ICON_RECTS];
+int IconRectCount = 0;
+bool IconOverflow = false;
+
+// Off screen RGB565 frame that scenes are composed in before being pushed
+// to the panel with DMA
+TFT_eSprite Frame = TFT_eSprite(&tft);
+
+// Where drawing goes: the frame, or straight to the panel if there was not
+// enough RAM for the frame or DMA could not be set up
+static TFT_eSPI * Canvas = &tft;
+bool UseFrame = false;
+
+// Size of the panel in its rotation. Only the drawing primitives of TFT_eSPI
+// are virtual, so Canvas->width()/height()/fillScreen() would use the
+// panel's unrotated size when Canvas is the frame.
+int16_t ScreenWidth = 0;
+int16_t ScreenHeight = 0;
+
+// Rows changed since the frame was last pushed (none if DirtyTop >= DirtyBottom)
+int16_t DirtyTop = 0;
+int16_t DirtyBottom = 0;
+
+// Nesting depth of lcd_BeginFrame()/lcd_EndFrame()
+int FrameDepth = 0;
+
+// A DMA push of the frame is in flight, so the frame must not be drawn
+// into until it finishes. The push holds the SPI bus lock, which belongs to
+// the task that started it, so only that task may finish it.
+bool Pushing = false;
+
+// When composing of the current frame started
+uint32_t FrameStartCycles;
+int FrameStartCore;
+
 /* Public variables ----------------------------------------------------------*/
 
 /* Private function prototypes -----------------------------------------------*/
@@ -60,57 +130,480 @@ TFT_eSPI tft = TFT_eSPI();  // Invoke library, pins defined in User_Setup.h
 
 /* Private functions ---------------------------------------------------------*/
 
+/**
+  * @brief  Wait for the frame's DMA push, if one is in flight, and close its
+  *         SPI transaction
+  * @param  none
+  * @retval none
+  */
+static void finishPush(void)
+{
+  if (Pushing)
+  {
+    tft.dmaWait();
+    tft.endWrite();
+    Pushing = false;
+  }
+}
+
+/**
+  * @brief  Note that some rows of the frame have been drawn into
+  * @param  y : First row drawn
+  * @param  height : Number of rows drawn
+  * @retval none
+  */
+void markDirty(int16_t y, int16_t height)
+{
+  DirtyTop = max((int16_t)0, min(DirtyTop, y));
+  DirtyBottom = min(ScreenHeight, max(DirtyBottom, (int16_t)(y + height)));
+}
+
+/**
+  * @brief  Draw one row of native byte order RGB565 pixels on the canvas,
+  *         clipped to the screen
+  * @param  x : X coordinate of the first pixel
+  * @param  y : Row to draw in
+  * @param  width : Number of pixels
+  * @param  pixels : RGB565 colors
+  * @param  transparent : true to leave ICON_TRANSPARENT pixels undrawn
+  * @retval none
+  */
+void drawRow(int16_t x, int16_t y, int16_t width, uint16_t * pixels, bool transparent)
+{
+  if (y < 0 || y >= ScreenHeight)
+  {
+    return;
+  }
+
+  // The frame holds pixels in panel byte order, so copy them in directly
+  if (UseFrame)
+  {
+    uint16_t * row = (uint16_t *)Frame.getPointer() + y * ScreenWidth;
+    for (int16_t i = 0; i < width; i++)
+    {
+      int16_t px = x + i;
+      uint16_t color = pixels[i];
+      if (px >= 0 && px < ScreenWidth && !(transparent && color == ICON_TRANSPARENT))
+      {
+        row[px] = (color << 8) | (color >> 8);
+      }
+    }
+    return;
+  }
+
+  // Straight to the panel, one push per opaque span
+  tft.setSwapBytes(true);
+  int16_t start = 0;
+  while (start < width)
+  {
+    while (transparent && start < width && pixels[start] == ICON_TRANSPARENT)
+    {
+      start++;
+    }
+    int16_t end = start;
+    while (end < width && !(transparent && pixels[end] == ICON_TRANSPARENT))
+    {
+      end++;
+    }
+    if (end > start)
+    {
+      tft.pushImage(x + start, y, end - start, 1, &pixels[start]);
+    }
+    start = end;
+  }
+}
+
+/**
+  * @brief  Draw a cached block of pixels on the canvas
+  * @param  x : X coordinate of the top left corner
+  * @param  y : Y coordinate of the top left corner
+  * @param  block : Pixels to draw
+  * @param  transparent : true to leave ICON_TRANSPARENT pixels undrawn
+  * @retval none
+  */
+static void drawBlock(int16_t x, int16_t y, const RasterBlock_t * block, bool transparent)
+{
+  // A solid block going straight to the panel is a single push
+  if (!UseFrame && !transparent)
+  {
+    tft.setSwapBytes(true);
+    tft.pushImage(x, y, block->width, block->height, block->pixels);
+    return;
+  }
+  for (int16_t row = 0; row < block->height; row++)
+  {
+    drawRow(x, y + row, block->width, &block->pixels[row * block->width], transparent);
+  }
+}
+
+/**
+  * @brief  Draw a line of text, from the cache if it is there. Otherwise it
+  *         is printed straight onto the canvas, and when that is the frame
+  *         the pixels it drew are offered to the cache.
+  * @param  text : Text to draw
+  * @param  top : Y coordinate of the top of the line
+  * @param  width : Width of the line, the text is cut off after this
+  * @param  height : Height of the line (the font's height)
+  * @retval none
+  */
+static void drawText(const char * text, int16_t top, int16_t width, int16_t height)
+{
+  const RasterBlock_t * block = rastercache_Find(RASTER_TEXT, text, TFT_YELLOW);
+  if (block != NULL)
+  {
+    drawBlock(LINE_X, top, block, false);
+    return;
+  }
+
+  Canvas->setCursor(LINE_X, top);
+  Canvas->print(text);
+
+  // The panel can't be read back, so only text drawn in the frame is cached
+  if (!UseFrame || top + height > ScreenHeight)
+  {
+    return;
+  }
+  RasterBlock_t * fresh = rastercache_Insert(RASTER_TEXT, text, TFT_YELLOW, width, height);
+  if (fresh == NULL)
+  {
+    return;
+  }
+
+  // The frame holds pixels in panel byte order, the cache in native order
+  const uint16_t * frame = (const uint16_t *)Frame.getPointer();
+  for (int16_t row = 0; row < height; row++)
+  {
+    const uint16_t * drawn = &frame[(top + row) * ScreenWidth + LINE_X];
+    uint16_t * pixels = &fresh->pixels[row * width];
+    for (int16_t i = 0; i < width; i++)
+    {
+      pixels[i] = (drawn[i] << 8) | (drawn[i] >> 8);
+    }
+  }
+}
+
+/**
+  * @brief  Get an icon as a block of pixels, from the cache or by decoding
+  *         it into a new cache entry
+  * @param  icon : Icon to get
+  * @retval The block, or NULL if it could not be cached
+  */
+static const RasterBlock_t * iconBlock(const IconAsset_t * icon)
+{
+  const RasterBlock_t * block = rastercache_Find(RASTER_ICON, icon->name, 0);
+  if (block != NULL)
+  {
+    return block;
+  }
+
+  RasterBlock_t * fresh = rastercache_Insert(RASTER_ICON, icon->name, 0, icon->width, icon->height);
+  if (fresh == NULL)
+  {
+    return NULL;
+  }
+
+  IconDecoder_t decoder;
+  icons_BeginDecode(&decoder, icon);
+  for (int row = 0; row < icon->height; row++)
+  {
+    uint16_t * line = &fresh->pixels[row * icon->width];
+    if (!icons_DecodeRow(&decoder, line))
+    {
+      // Leave the rest of a corrupt icon transparent
+      LOGGER_ERROR("Icon %s is corrupt at row %d", icon->name, row);
+      for (int i = row * icon->width; i < icon->width * icon->height; i++)
+      {
+        fresh->pixels[i] = ICON_TRANSPARENT;
+      }
+      break;
+    }
+  }
+  return fresh;
+}
+
+/**
+  * @brief  Clear the whole canvas to black
+  * @param  none
+  * @retval none
+  */
+void clearCanvas(void)
+{
+  Canvas->fillRect(0, 0, ScreenWidth, ScreenHeight, TFT_BLACK);
+}
+
+/**
+  * @brief  Top edge of a line of text. The first line starts one pixel down,
+  *         the others every LINE_HEIGHT pixels.
+  * @param  line : Line number, 0 to LCD_LINE_COUNT - 1
+  * @retval Y coordinate of the top of the line
+  */
+int16_t lineTop(int line)
+{
+  return (line == 0) ? 1 : line * LINE_HEIGHT;
+}
+
+/**
+  * @brief  Clear the icons drawn since the last text update, and mark the
+  *         lines they covered so they get redrawn
+  * @param  none
+  * @retval none
+  */
+void clearIcons(void)
+{
+  int16_t fontHeight = Canvas->fontHeight(LINE_FONT);
+
+  for (int i = 0; i < IconRectCount; i++)
+  {
+    IconRect_t * rect = &IconRects[i];
+    Canvas->fillRect(rect->x, rect->y, rect->width, rect->height, TFT_BLACK);
+    markDirty(rect->y, rect->height);
+    for (int line = 0; line < LCD_LINE_COUNT; line++)
+    {
+      int16_t top = lineTop(line);
+      if (rect->y < top + fontHeight && rect->y + rect->height > top)
+      {
+        Lines[line].valid = false;
+      }
+    }
+  }
+  IconRectCount = 0;
+}
+
+/**
+  * @brief  Bring one line of text on the screen up to date. Nothing is sent
+  *         to the display if the line already shows this text.
+  * @param  line : Line number, 0 to LCD_LINE_COUNT - 1
+  * @param  text : Text the line should show
+  * @retval none
+  */
+void updateLine(int line, const char * text)
+{
+  LineState_t * state = &Lines[line];
+  size_t length = strlen(text);
+
+  // Text too long to remember is always redrawn
+  if (state->valid && length < LCD_LINE_TEXT_SIZE && strcmp(state->text, text) == 0)
+  {
+    metrics_Increment(METRIC_LCD_LINES_SKIPPED);
+    return;
+  }
+
+  int16_t top = lineTop(line);
+  int16_t height = Canvas->fontHeight(LINE_FONT);
+  int16_t width = min(Canvas->textWidth(text, LINE_FONT), (int16_t)(ScreenWidth - LINE_X));
+
+  // The text comes with its own background, so only the part of the old
+  // text that sticks out past the new text needs clearing
+  if (width > 0)
+  {
+    drawText(text, top, width, height);
+  }
+  if (state->width > width)
+  {
+    Canvas->fillRect(LINE_X + width, top, state->width - width, height, TFT_BLACK);
+  }
+
+  markDirty(top, height);
+
+  strlcpy(state->text, text, sizeof(state->text));
+  state->width = width;
+  state->valid = true;
+  metrics_Increment(METRIC_LCD_LINES_DRAWN);
+}
+
 /* Public functions ---------------------------------------------------------*/
 
 // See header file for documentation block
-void lcd_DisplayIP(void)
+void lcd_BeginFrame(void)
 {
-  tft.fillScreen(TFT_BLACK);
-  tft.setTextFont(4);
-  tft.setCursor (8, 40);
-  tft.print("My IP address:");
-  tft.setCursor (8, 70);
-  tft.print(WiFi.localIP());
+  if (FrameDepth++ > 0)
+  {
+    return;
+  }
+
+  // The frame is the DMA source, so let the last push finish first
+  finishPush();
+  DirtyTop = ScreenHeight;
+  DirtyBottom = 0;
+  FrameStartCore = xPortGetCoreID();
+  FrameStartCycles = metrics_Start();
 }
 
 // See header file for documentation block
-void lcd_DisplayWaiting(void)
+void lcd_EndFrame(void)
 {
-  tft.fillScreen(TFT_BLACK);
-  tft.setCursor (8, 40);
-  tft.print("Waiting for data");
+  if (FrameDepth == 0 || --FrameDepth > 0)
+  {
+    return;
+  }
+  if (DirtyTop >= DirtyBottom)
+  {
+    return;
+  }
 
-  // Swap the colour byte order when rendering
-  tft.setSwapBytes(true);
+  // Full width rows are contiguous in the frame, so the changed band goes
+  // out as one window. The frame already holds pixels in panel byte order.
+  if (UseFrame)
+  {
+    uint16_t * pixels = (uint16_t *)Frame.getPointer();
+    tft.startWrite();
+    tft.pushImageDMA(0, DirtyTop, ScreenWidth, DirtyBottom - DirtyTop,
+      pixels + DirtyTop * ScreenWidth);
+    Pushing = true;
+  }
+  metrics_Record(METRIC_LCD_FRAME, FrameStartCycles, FrameStartCore);
+  metrics_Increment(METRIC_LCD_FRAMES);
 }
 
-
 // See header file for documentation block
 void lcd_printTextLines(const char * text1, const char * text2, const char * text3, const char * text4)
 {
-  tft.fillScreen(TFT_BLACK);
-  tft.setTextFont(4);
-  tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-#define LINE_HEIGHT 36
-  tft.setCursor (1, 1);
-  tft.print(text1);
-  tft.setCursor (1, LINE_HEIGHT);
-  tft.print(text2);
-  tft.setCursor (1, 2 * LINE_HEIGHT);
-  tft.print(text3);
-  tft.setCursor (1, 3 * LINE_HEIGHT);
-  tft.print(text4);
+  MetricsScope timer(METRIC_LCD_TEXT);
+  const char * texts[LCD_LINE_COUNT] = { text1, text2, text3, text4 };
+
+  lcd_BeginFrame();
+
+  // Start from a blank screen if we don't know what is on it
+  if (!ScreenValid || IconOverflow)
+  {
+    clearCanvas();
+    for (int line = 0; line < LCD_LINE_COUNT; line++)
+    {
+      Lines[line].valid = false;
+      Lines[line].width = 0;
+    }
+    IconRectCount = 0;
+    IconOverflow = false;
+    ScreenValid = true;
+    markDirty(0, ScreenHeight);
+  }
+  else
+  {
+    clearIcons();
+  }
+
+  Canvas->setTextFont(LINE_FONT);
+  Canvas->setTextColor(TFT_YELLOW, TFT_BLACK);
+  for (int line = 0; line < LCD_LINE_COUNT; line++)
+  {
+    updateLine(line, texts[line]);
+  }
+
+  lcd_EndFrame();
+}
+
+// See header file for documentation block
+bool lcd_IsIconKnown(const char * iconName)
+{
+  return icons_Find(iconName) != NULL;
+}
+
+// See header file for documentation block
+bool lcd_DrawIcon(const char * iconName, int x, int y)
+{
+  const IconAsset_t * icon = icons_Find(iconName);
+  if (icon == NULL)
+  {
+    return false;
+  }
+
+  lcd_BeginFrame();
+  const RasterBlock_t * block = iconBlock(icon);
+  if (block != NULL)
+  {
+    drawBlock(x, y, block, true);
+  }
+  else
+  {
+    // Not cacheable, so decode one row at a time straight onto the canvas
+    IconDecoder_t decoder;
+    uint16_t line[ICON_MAX_WIDTH];
+
+    icons_BeginDecode(&decoder, icon);
+    for (int row = 0; row < icon->height; row++)
+    {
+      if (!icons_DecodeRow(&decoder, line))
+      {
+        LOGGER_ERROR("Icon %s is corrupt at row %d", iconName, row);
+        break;
+      }
+      drawRow(x, y + row, icon->width, line, true);
+    }
+  }
+  markDirty(y, icon->height);
+  lcd_EndFrame();
+
+  // Remember where it went so the next text update can clear it
+  if (IconRectCount < LCD_MAX_ICON_RECTS)
+  {
+    IconRects[IconRectCount].x = x;
+    IconRects[IconRectCount].y = y;
+    IconRects[IconRectCount].width = icon->width;
+    IconRects[IconRectCount].height = icon->height;
+    IconRectCount++;
+  }
+  else
+  {
+    IconOverflow = true;
+  }
+  return true;
+}
+
+// See header file for documentation block
+void lcd_Reserve(void)
+{
+  // Landscape (rotation 1), so the panel's height is the frame's width
+  Frame.setColorDepth(16);
+  Frame.createSprite(TFT_HEIGHT, TFT_WIDTH);
 }
 
 // See header file for documentation block
 void lcd_Init(void)
 {
+  rastercache_Init();
   tft.init();
   tft.setRotation(1);
   tft.fillScreen(TFT_BLACK);
+  ScreenWidth = tft.width();
+  ScreenHeight = tft.height();
+
+  // Compose in a full screen frame if there is RAM for it
+  if (!Frame.created())
+  {
+    Frame.setColorDepth(16);
+    Frame.createSprite(ScreenWidth, ScreenHeight);
+  }
+  if (Frame.created())
+  {
+    if (tft.initDMA())
+    {
+      Canvas = &Frame;
+      UseFrame = true;
+    }
+    else
+    {
+      Frame.deleteSprite();
+    }
+  }
+  if (!UseFrame)
+  {
+    LOGGER_WARN("LCD frame not available, drawing straight to the panel");
+  }
+
+  // Wrapping uses the non-virtual width(), and the text lines are laid out
+  // one row each anyway
+  Canvas->setTextWrap(false, false);
+
+  lcd_BeginFrame();
+  clearCanvas();
+  Canvas->setTextColor(TFT_YELLOW, TFT_BLACK); // Note: the new fonts do not draw the background colour
+  Canvas->setTextFont(4);
+  Canvas->setCursor (8, 40);
+  Canvas->print("Connecting to WiFi");
+  markDirty(0, ScreenHeight);
+  lcd_EndFrame();
 
-  tft.setTextColor(TFT_YELLOW, TFT_BLACK); // Note: the new fonts do not draw the background colour
-  tft.setTextFont(4);
-  tft.setCursor (8, 40);
-  tft.print("Connecting to WiFi");
+  // This runs in a boot task that ends right after, and the render task
+  // can't release the bus lock on its behalf
+  finishPush();
 }
\ No newline at end of file
@@ -36,9 +36,13 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <FreeRTOS.h>
-#include <Adafruit_NeoPixel.h>
-#include <FreeRTOS.h>
+#include <esp_timer.h>
 #include "led.h"
+#include "ledstrip.h"
+#include "anim.h"
+#include "logger.h"
+#include "metrics.h"
+#include "topology.h"
 
 /* Private typedef -----------------------------------------------------------*/
 
@@ -49,31 +53,31 @@
 
 #define LEDEffectSolid      0 // no effect (solid colors)
 #define LEDEffectBlink      1 // blinking (all LEDs do same thing)
+#define LEDEffectBreathe    2 // breathing (all LEDs fade up and down together)
 #define LEDEffectSwirl      3 // swirl (circular dimming effect)
+#define LEDEffectChase      4 // chase (one LED with a fading tail goes around)
+
+// Task notification bits for the effects task
+#define LED_NOTIFY_SETTINGS 0x01  // led_changeEffect() posted new settings
+#define LED_NOTIFY_FRAME    0x02  // the frame timer expired
 
 /* Private macro -------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
 
-/// NOTE: Using globals to share data with a task is not good practice (i.e. posible non-atomic access
-/// to the values).
-/// TODO: Switch to RTOS functions like message buffers to move data between tasks, or use semiphores
-/// to protect access to these globals
+// Animation posted by led_playAnimation() for the effects task to pick up
+Animation_t PendingAnimation;
+portMUX_TYPE SettingsLock = portMUX_INITIALIZER_UNLOCKED;
 
-// Holds the global state of the current LED effect.
-uint8_t LEDEffect = LEDEffectSolid;
+// Frame rate given to animations built by led_changeEffect()
+uint8_t FrameRate = ANIM_DEFAULT_FPS;
 
-// Global variables for LED effects. Used in runLEDEffects()
-uint32_t LEDBlinkTimer;
-uint32_t LEDBlinkOnReloadMS;
-uint32_t LEDBlinkOffReloadMS;
-uint8_t LEDBlinkState;
-uint8_t LEDRed;
-uint8_t LEDGreen;
-uint8_t LEDBlue;
+// The effects task, and the one-shot timer that wakes it when a frame is due
+TaskHandle_t EffectsTask = NULL;
+esp_timer_handle_t FrameTimer;
 
-// Neopixel LEDs strip
-Adafruit_NeoPixel pixels(NUM_OF_LEDS, PIN, NEO_GRB + NEO_KHZ800);
+// Neopixel LEDs strip, sent out by the RMT peripheral
+LEDStrip pixels(NUM_OF_LEDS, PIN, RMT_CHANNEL_0);
 
 /* Public variables ----------------------------------------------------------*/
 
@@ -82,106 +86,215 @@ Adafruit_NeoPixel pixels(NUM_OF_LEDS, PIN, NEO_GRB + NEO_KHZ800);
 /* Private functions ---------------------------------------------------------*/
 
 /**
-  * @brief  LED Effects Task. Runs continually. Based on selected effect, do
-  *         blinking or whatever is necessary
+  * @brief  Start sending the current pixel colors out to the LEDs, timing how
+  *         long it takes to hand them to the RMT
+  * @param  none
+  * @retval none
+  */
+void showPixels(void)
+{
+  MetricsScope timer(METRIC_LED_SHOW);
+  pixels.show();
+}
+
+/**
+  * @brief  Frame timer callback. Runs in the esp_timer task, just wakes the
+  *         effects task.
+  * @param  arg : ignored
+  * @retval none
+  */
+void frameTimerExpired(void * arg)
+{
+  xTaskNotify(EffectsTask, LED_NOTIFY_FRAME, eSetBits);
+}
+
+/**
+  * @brief  Arm the frame timer to wake the effects task at an absolute time.
+  *         Deadlines are absolute so blink periods don't drift.
+  * @param  deadlineUs : esp_timer_get_time() value the next frame is due at
+  * @retval none
+  */
+void scheduleFrame(int64_t deadlineUs)
+{
+  int64_t delayUs = deadlineUs - esp_timer_get_time();
+
+  esp_timer_stop(FrameTimer);
+  esp_timer_start_once(FrameTimer, (delayUs > 0) ? delayUs : 0);
+}
+
+/**
+  * @brief  Render one frame of an animation and send it to the LEDs
+  * @param  anim : Animation being shown
+  * @param  elapsedMs : Time since the animation started
+  * @retval none
+  */
+void showFrame(const Animation_t * anim, uint32_t elapsedMs)
+{
+  uint8_t frame[NUM_OF_LEDS][3];
+
+  anim_Render(anim, elapsedMs, frame, NUM_OF_LEDS);
+  for (int i = 0; i < NUM_OF_LEDS; i++)
+  {
+    pixels.setPixelColor(i, frame[i][0], frame[i][1], frame[i][2]);
+  }
+  showPixels();
+}
+
+/**
+  * @brief  LED Effects Task. Sleeps until either a new animation arrives or
+  *         the next frame of the current one is due, so solid colors cost
+  *         nothing and blink edges land on exact millisecond deadlines.
   * @param  parameter : ignored
   * @retval none
   */
 void RunEffects(void * parameter)
 {
-   for (;;) {
-    switch (LEDEffect)
+  static Animation_t anim;
+  int64_t startUs = 0;
+  uint32_t frameMs = 0;
+  uint32_t nextMs = ANIM_FOREVER;
+
+  anim_PresetSolid(&anim, 0, 0, 0);
+
+  for (;;) {
+    uint32_t events = 0;
+    xTaskNotifyWait(0, ULONG_MAX, &events, portMAX_DELAY);
+
+    if (events & LED_NOTIFY_SETTINGS)
     {
-      case LEDEffectSolid:
-      default:
-        // Nothing to do for solid color case
-        LEDBlinkState = false;
-        LEDBlinkTimer = 0;
-        break;
-
-      case LEDEffectBlink:
-        if (LEDBlinkTimer)
-        {
-          LEDBlinkTimer--;
-        }
-        if (!LEDBlinkTimer)
-        {
-          if (LEDBlinkState)
-          {
-            LEDBlinkState = false;
-            LEDBlinkTimer = LEDBlinkOffReloadMS;
-            pixels.fill(pixels.Color(0, 0, 0));
-            delay(1);
-            pixels.show();
-          }
-          else
-          {
-            LEDBlinkState = true;
-            LEDBlinkTimer = LEDBlinkOnReloadMS;
-            pixels.fill(pixels.Color(LEDRed, LEDGreen, LEDBlue));
-            delay(1);
-            pixels.show();
-          }
-        }
-        break;
-
-      case LEDEffectSwirl:
-        /// TODO: Implemenent LED Swirl effect
-        break;
+      esp_timer_stop(FrameTimer);
+      portENTER_CRITICAL(&SettingsLock);
+      anim = PendingAnimation;
+      portEXIT_CRITICAL(&SettingsLock);
+
+      startUs = esp_timer_get_time();
+      frameMs = 0;
+    }
+    else if ((events & LED_NOTIFY_FRAME) && nextMs != ANIM_FOREVER)
+    {
+      int64_t nowUs = esp_timer_get_time();
+
+      // A timer that expired just as the animation changed can wake us early
+      if (nowUs < startUs + (int64_t)nextMs * 1000)
+      {
+        scheduleFrame(startUs + (int64_t)nextMs * 1000);
+        continue;
+      }
+
+      // Stay on the planned frame times unless we have fallen a frame behind
+      uint32_t actualMs = (nowUs - startUs) / 1000;
+      frameMs = (actualMs - nextMs > 1000 / anim.fps) ? actualMs : nextMs;
+    }
+    else
+    {
+      continue;
+    }
+
+    showFrame(&anim, frameMs);
+
+    // Sleep until the next frame is due, or forever if nothing will change
+    uint32_t untilNext = anim_NextFrameMs(&anim, frameMs);
+    if (untilNext == ANIM_FOREVER)
+    {
+      nextMs = ANIM_FOREVER;
+    }
+    else
+    {
+      nextMs = frameMs + untilNext;
+      scheduleFrame(startUs + (int64_t)nextMs * 1000);
     }
-    // Wait for just 1 ms
-    vTaskDelay(portTICK_PERIOD_MS);
   }
 }
 
 /* Public functions ---------------------------------------------------------*/
 
+// See header file for documentation block
+void led_playAnimation(const Animation_t * anim)
+{
+  portENTER_CRITICAL(&SettingsLock);
+  PendingAnimation = *anim;
+  if (PendingAnimation.fps == 0)
+  {
+    PendingAnimation.fps = FrameRate;
+  }
+  portEXIT_CRITICAL(&SettingsLock);
+
+  xTaskNotify(EffectsTask, LED_NOTIFY_SETTINGS, eSetBits);
+}
+
 // See header file for documentation block
 void led_changeEffect(uint8_t red, uint8_t green, uint8_t blue, uint8_t newEffect, uint32_t onTime, uint32_t offTime)
 {
-  LEDEffect = newEffect;
+  Animation_t anim;
 
-  switch(LEDEffect)
+  switch (newEffect)
   {
     case LEDEffectSolid:
     default:
-      pixels.fill(pixels.Color(red, green, blue));
-      delay(30);
-      pixels.show();
+      anim_PresetSolid(&anim, red, green, blue);
       break;
 
     case LEDEffectBlink:
-      pixels.fill(pixels.Color(red, green, blue));
-      delay(30);
-      pixels.show();
-      LEDBlinkState = true;
-      LEDBlinkOffReloadMS = offTime;
-      LEDBlinkOnReloadMS = onTime;
-      LEDBlinkTimer = LEDBlinkOnReloadMS;
+      anim_PresetBlink(&anim, red, green, blue, onTime, offTime);
       break;
-    
+
+    case LEDEffectBreathe:
+      anim_PresetBreathe(&anim, red, green, blue, onTime);
+      break;
+
     case LEDEffectSwirl:
+      anim_PresetSwirl(&anim, red, green, blue, onTime);
+      break;
 
+    case LEDEffectChase:
+      anim_PresetChase(&anim, red, green, blue, onTime);
       break;
   }
-  LEDRed = red;
-  LEDGreen = green;
-  LEDBlue = blue;
+  anim.fps = FrameRate;
+  led_playAnimation(&anim);
+}
+
+// See header file for documentation block
+bool led_changeSeverity(uint8_t severity)
+{
+  Animation_t anim;
+
+  if (!anim_PresetSeverity(&anim, severity))
+  {
+    return false;
+  }
+  anim.fps = FrameRate;
+  led_playAnimation(&anim);
+  return true;
+}
+
+// See header file for documentation block
+void led_setFrameRate(uint8_t fps)
+{
+  if (fps > 0)
+  {
+    FrameRate = fps;
+  }
 }
 
 // See header file for documentation block
 void led_Init(void) 
 {
   // Initialize Neopixel
-  pixels.begin();
-  led_changeEffect(0, 0, 0, LEDEffectSolid, 0, 0);
+  if (!pixels.begin())
+  {
+    LOGGER_ERROR("Could not set up RMT for the LEDs");
+  }
 
-  xTaskCreate(
-    RunEffects,    
-    "LED Effects",   // Name of the task (for debugging)
-    1000,            // Stack size (bytes)
-    NULL,            // Parameter to pass
-    2,               // Task priority
-    NULL             // Task handle
-  );
-}
+  topology_Create(TASK_LED, RunEffects, NULL, &EffectsTask);
+
+  const esp_timer_create_args_t timerArgs = {
+    .callback = frameTimerExpired,
+    .arg = NULL,
+    .dispatch_method = ESP_TIMER_TASK,
+    .name = "LED frame",
+  };
+  esp_timer_create(&timerArgs, &FrameTimer);
+
+  led_changeEffect(0, 0, 0, LEDEffectSolid, 0, 0);
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+/**
+  ******************************************************************************
+  * @file    ledstrip.cpp
+  * @author  Brian Schmalz
+  * @brief   Non-blocking RMT driven WS2812 LED strip
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "ledstrip.h"
+#include "metrics.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+// RMT clock is the 80 MHz APB clock divided by 2, so one tick is 25 ns
+#define LEDSTRIP_CLK_DIV    2
+
+// WS2812 bit timings in RMT ticks
+#define LEDSTRIP_T0H        16    // 0.40 us
+#define LEDSTRIP_T0L        34    // 0.85 us
+#define LEDSTRIP_T1H        32    // 0.80 us
+#define LEDSTRIP_T1L        18    // 0.45 us
+
+// Low time between frames that latches the colors (datasheet minimum is 50 us)
+#define LEDSTRIP_RESET_US   80
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  RMT end of transmit callback. Runs in the RMT interrupt handler,
+  *         so it only records how long the frame took to send.
+  * @param  channel : RMT channel that finished
+  * @param  arg : LEDStrip that owns the channel
+  * @retval none
+  */
+void LEDStrip::transmitDone(rmt_channel_t channel, void * arg)
+{
+  LEDStrip * strip = (LEDStrip *)arg;
+
+  if (channel != strip->channel)
+  {
+    return;
+  }
+  strip->endUs = esp_timer_get_time();
+  strip->transmitUs = strip->endUs - strip->startUs;
+  metrics_RecordUs(METRIC_LED_TRANSMIT, strip->transmitUs);
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+LEDStrip::LEDStrip(uint16_t numPixels, uint8_t pin, rmt_channel_t channel)
+{
+  this->count = numPixels;
+  this->pin = pin;
+  this->channel = channel;
+  pixels = NULL;
+  items[0] = NULL;
+  items[1] = NULL;
+  back = 0;
+  sending = false;
+  startUs = 0;
+  endUs = 0;
+  transmitUs = 0;
+}
+
+bool LEDStrip::begin(void)
+{
+  rmt_config_t config;
+
+  pixels = (uint8_t *)calloc(count, 3);
+  items[0] = (rmt_item32_t *)calloc(count * 24, sizeof(rmt_item32_t));
+  items[1] = (rmt_item32_t *)calloc(count * 24, sizeof(rmt_item32_t));
+  if (pixels == NULL || items[0] == NULL || items[1] == NULL)
+  {
+    return false;
+  }
+
+  memset(&config, 0, sizeof(config));
+  config.rmt_mode = RMT_MODE_TX;
+  config.channel = channel;
+  config.gpio_num = (gpio_num_t)pin;
+  config.clk_div = LEDSTRIP_CLK_DIV;
+  config.mem_block_num = 1;
+  config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+  config.tx_config.idle_output_en = true;
+
+  if (rmt_config(&config) != ESP_OK ||
+      rmt_driver_install(channel, 0, 0) != ESP_OK)
+  {
+    return false;
+  }
+  rmt_register_tx_end_callback(transmitDone, this);
+  return true;
+}
+
+void LEDStrip::setPixelColor(uint16_t n, uint8_t red, uint8_t green, uint8_t blue)
+{
+  if (n >= count || pixels == NULL)
+  {
+    return;
+  }
+  pixels[n * 3 + 0] = green;
+  pixels[n * 3 + 1] = red;
+  pixels[n * 3 + 2] = blue;
+}
+
+void LEDStrip::setPixelColor(uint16_t n, uint32_t color)
+{
+  setPixelColor(n, (color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
+}
+
+void LEDStrip::fill(uint32_t color)
+{
+  for (uint16_t i = 0; i < count; i++)
+  {
+    setPixelColor(i, color);
+  }
+}
+
+void LEDStrip::clear(void)
+{
+  if (pixels != NULL)
+  {
+    memset(pixels, 0, count * 3);
+  }
+}
+
+void LEDStrip::show(void)
+{
+  if (pixels == NULL)
+  {
+    return;
+  }
+
+  // Build the new frame in the buffer the RMT is not reading from
+  rmt_item32_t * item = items[back];
+  for (int i = 0; i < count * 3; i++)
+  {
+    for (uint8_t mask = 0x80; mask != 0; mask >>= 1)
+    {
+      bool one = (pixels[i] & mask) != 0;
+      item->level0 = 1;
+      item->duration0 = one ? LEDSTRIP_T1H : LEDSTRIP_T0H;
+      item->level1 = 0;
+      item->duration1 = one ? LEDSTRIP_T1L : LEDSTRIP_T0L;
+      item++;
+    }
+  }
+
+  // The previous frame (well under a millisecond for a small ring) is
+  // normally long done by now. Make sure the latch time has passed too.
+  if (sending)
+  {
+    rmt_wait_tx_done(channel, pdMS_TO_TICKS(10));
+    int64_t sinceEnd = esp_timer_get_time() - endUs;
+    if (sinceEnd < LEDSTRIP_RESET_US)
+    {
+      delayMicroseconds(LEDSTRIP_RESET_US - sinceEnd);
+    }
+  }
+
+  // Hand the buffer to the RMT and build the next frame in the other one
+  startUs = esp_timer_get_time();
+  rmt_write_items(channel, items[back], count * 24, false);
+  sending = true;
+  back ^= 1;
+}
+
+uint16_t LEDStrip::numPixels(void) const
+{
+  return count;
+}
+
+uint32_t LEDStrip::lastTransmitUs(void) const
+{
+  return transmitUs;
+}
+
+uint32_t LEDStrip::Color(uint8_t red, uint8_t green, uint8_t blue)
+{
+  return ((uint32_t)red << 16) | ((uint32_t)green << 8) | blue;
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+/**
+  ******************************************************************************
+  * @file    logger.cpp
+  * @author  Brian Schmalz
+  * @brief   Asynchronous ring buffer logger
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <FreeRTOS.h>
+#include <stdarg.h>
+#include <atomic>
+#include "logger.h"
+#include "topology.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+// One message slot in the ring. seq tells producers and the drain task
+// whose turn it is to use the slot (bounded MPSC queue, Vyukov style).
+typedef struct {
+  std::atomic<uint32_t> seq;
+  uint16_t length;
+  char text[LOGGER_MSG_SIZE];
+} LoggerSlot_t;
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+// Message ring. Producers claim slots with a CAS on Head, the drain task
+// is the only consumer and owns Tail.
+static LoggerSlot_t Slots[LOGGER_SLOTS];
+static std::atomic<uint32_t> Head(0);
+static uint32_t Tail;
+
+// Messages lost because the ring was full
+static std::atomic<uint32_t> Dropped(0);
+
+// Drain task, notified whenever a message is queued
+static TaskHandle_t DrainTask = NULL;
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Log drain task. Sleeps until messages are queued, then writes
+  *         them out the UART. Runs at low priority so a slow UART only ever
+  *         delays the log, never the code doing the logging.
+  * @param  parameter : ignored
+  * @retval none
+  */
+static void DrainLog(void * parameter)
+{
+  uint32_t reportedDrops = 0;
+
+  for (;;)
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    for (;;)
+    {
+      LoggerSlot_t * slot = &Slots[Tail % LOGGER_SLOTS];
+      if (slot->seq.load(std::memory_order_acquire) != Tail + 1)
+      {
+        break;
+      }
+      Serial.write((const uint8_t *)slot->text, slot->length);
+      Serial.write("\r\n");
+      slot->seq.store(Tail + LOGGER_SLOTS, std::memory_order_release);
+      Tail++;
+    }
+
+    uint32_t drops = Dropped.load(std::memory_order_relaxed);
+    if (drops != reportedDrops)
+    {
+      Serial.printf("%u log messages dropped\r\n", (unsigned)(drops - reportedDrops));
+      reportedDrops = drops;
+    }
+  }
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+void logger_Write(char level, const char * format, ...)
+{
+  if (DrainTask == NULL)
+  {
+    return;
+  }
+
+  // Claim a slot without ever waiting on the drain task
+  uint32_t pos = Head.load(std::memory_order_relaxed);
+  LoggerSlot_t * slot;
+  for (;;)
+  {
+    slot = &Slots[pos % LOGGER_SLOTS];
+    int32_t diff = (int32_t)(slot->seq.load(std::memory_order_acquire) - pos);
+    if (diff == 0)
+    {
+      if (Head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if (diff < 0)
+    {
+      // Ring is full
+      Dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    else
+    {
+      pos = Head.load(std::memory_order_relaxed);
+    }
+  }
+
+  int len = snprintf(slot->text, LOGGER_MSG_SIZE, "%lu %c ", (unsigned long)millis(), level);
+  va_list args;
+  va_start(args, format);
+  len += vsnprintf(slot->text + len, LOGGER_MSG_SIZE - len, format, args);
+  va_end(args);
+  if (len >= LOGGER_MSG_SIZE)
+  {
+    len = LOGGER_MSG_SIZE - 1;
+  }
+  slot->length = len;
+
+  // Hand the slot to the drain task
+  slot->seq.store(pos + 1, std::memory_order_release);
+  xTaskNotifyGive(DrainTask);
+}
+
+// See header file for documentation block
+uint32_t logger_GetDropped(void)
+{
+  return Dropped.load(std::memory_order_relaxed);
+}
+
+// See header file for documentation block
+void logger_Init(void)
+{
+  for (uint32_t i = 0; i < LOGGER_SLOTS; i++)
+  {
+    Slots[i].seq.store(i, std::memory_order_relaxed);
+  }
+  Head.store(0, std::memory_order_relaxed);
+  Tail = 0;
+
+  topology_Create(TASK_LOG_DRAIN, DrainLog, NULL, &DrainTask);
+}
\ No newline at end of file
@@ -38,15 +38,25 @@
 #include <WiFi.h>
 #include <FreeRTOS.h>
 
+#include "boot.h"
 #include "sensor.h"
 #include "handlers.h"
 #include "led.h"
 #include "lcd.h"
+#include "logger.h"
+#include "metrics.h"
+#include "render.h"
+#include "taskstats.h"
+#include "topology.h"
+#include "wifimgr.h"
 
 /* Private typedef -----------------------------------------------------------*/
 
 /* Private define ------------------------------------------------------------*/
 
+// How long the IP address is shown once we are on the network
+#define SPLASH_MS           4000
+
 /* Private macro -------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
@@ -65,50 +75,97 @@ const char *PWD = "calabre4";
 /* Private functions ---------------------------------------------------------*/
 
 /**
-  * @brief Connects to WiFi access point. Keeps trying forever.
-  * @note  
+  * @brief Show the IP address that DHCP gave to us for SPLASH_MS. The first
+  *        time, also put up a 'waiting for data' message underneath that
+  *        stays until something is sent to us. The render task takes the
+  *        IP address down on its own.
+  * @param first : true the first time we are on the network
+  * @retval none
+  */
+static void showSplash(bool first)
+{
+  RenderCommand_t command = {};
+
+  command.parts = RENDER_PART_LCD;
+  if (first)
+  {
+    command.priority = RENDER_PRIORITY_AMBIENT;
+    strlcpy(command.lcd.text[0], "Waiting for data", RENDER_TEXT_SIZE);
+    render_Submit(&command);
+  }
+
+  /// TODO: Add version string printout to IP display screen
+  command.priority = RENDER_PRIORITY_ADVISORY;
+  command.durationMs = SPLASH_MS;
+  strlcpy(command.lcd.text[0], "My IP address:", RENDER_TEXT_SIZE);
+  strlcpy(command.lcd.text[1], WiFi.localIP().toString().c_str(), RENDER_TEXT_SIZE);
+  render_Submit(&command);
+}
+
+/**
+  * @brief Called by the WiFi manager each time we get an address. The HTTP
+  *        server is started the first time; it listens on every address,
+  *        so it carries on serving by itself after a reconnect. The IP
+  *        address is shown every time.
   * @param none
   * @retval none
   */
-void connectToWiFi(void) 
+static void onNetworkUp(void)
 {
-  Serial.print("Connecting to ");
-  Serial.println(SSID);
-  
-  WiFi.begin(SSID, PWD);
-  
-  while (WiFi.status() != WL_CONNECTED) 
+  bool first = (boot_GetStageUs(BOOT_STAGE_SERVER) == 0);
+
+  // Set the clock over SNTP (UTC) so sample history has real timestamps
+  configTime(0, 0, "pool.ntp.org");
+
+  // The LCD says 'Connecting to WiFi' until the splash goes up, which needs
+  // the render task. It is normally up long before WiFi is, and display
+  // requests would get 429 until then anyway.
+  boot_Wait(BOOT_BIT(BOOT_STAGE_RENDER), BOOT_WAIT_FOREVER);
+
+  // The ambient splash goes in before the server can take any requests,
+  // so it never covers one
+  showSplash(first);
+  if (first)
   {
-    Serial.print(".");
-    delay(500); 
+    handlers_Init();
+    boot_Mark(BOOT_STAGE_SERVER);
   }
- 
-  Serial.print("Connected. IP: ");
-  Serial.println(WiFi.localIP());
 }
  
 /* Public functions ---------------------------------------------------------*/
 
 /**
   * @brief Arduino setup() function. Called once by Arduino core at boot
-  * @note  
+  * @note  The display, LEDs and sensor are brought up in tasks of their own
+  *        while WiFi associates, and the server starts the moment we have
+  *        an address. Returns once the render task is up, without waiting
+  *        for WiFi. Stage times are served on /debug/boot.
   * @param none
   * @retval none
   */
 void setup(void) 
 {
-  // Initialize all the things.
   Serial.begin(9600);
-  sensor_Init();
-  lcd_Init();
-  connectToWiFi();
-  handlers_Init();
-  // Display the IP address that DHCP gave to us on the LCD display for 4 seconds
-  /// TODO: Add version string printout to IP display screen
-  lcd_DisplayIP();
-  delay(4000);
-  // Print a 'waiting for data' message until something is sent to us
-  lcd_DisplayWaiting();
+  logger_Init();
+  metrics_Init();
+  taskstats_Init();
+  boot_Init();
+
+  // The LCD frame is the biggest single allocation, so take it before
+  // WiFi starts breaking up the heap
+  lcd_Reserve();
+
+  // Initialize all the things, side by side
+  boot_Start(TASK_BOOT_LCD, lcd_Init, BOOT_STAGE_LCD);
+  boot_Start(TASK_BOOT_LED, led_Init, BOOT_STAGE_LED);
+  boot_Start(TASK_BOOT_SENSOR, sensor_Init, BOOT_STAGE_SENSOR);
+  wifimgr_Init(SSID, PWD, onNetworkUp);
+
+  // From here on only the render task touches the LCD and LEDs. Display
+  // requests that arrive before this are answered with 429.
+  boot_Wait(BOOT_BIT(BOOT_STAGE_LCD) | BOOT_BIT(BOOT_STAGE_LED), BOOT_WAIT_FOREVER);
+  render_Init();
+  boot_Mark(BOOT_STAGE_RENDER);
 }
  
 /**
@@ -120,4 +177,6 @@ void setup(void)
  void loop(void) 
 {
   handlers_Run();
+  topology_CheckStacks();
+  taskstats_Sample();
 }
\ No newline at end of file
@@ -0,0 +1,388 @@
+/**
+  ******************************************************************************
+  * @file    metrics.cpp
+  * @author  Brian Schmalz
+  * @brief   Latency histograms and counters, exported in Prometheus format
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <FreeRTOS.h>
+#include <atomic>
+#include "metrics.h"
+#include "logger.h"
+#include "rastercache.h"
+#include "sensor.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+// One latency histogram. Bucket counts are not cumulative here, they are
+// summed up when printed. The sum is 64 bits: 32 would wrap after 71
+// minutes of accumulated time, which Prometheus takes for a reset.
+typedef struct {
+  std::atomic<uint32_t> buckets[METRICS_BUCKETS + 1];
+  std::atomic<uint64_t> sumUs;
+  std::atomic<uint32_t> discarded;
+} Histogram_t;
+
+// Groups of lines of the exposition, in the order they are written
+typedef enum {
+  METRICS_SECTION_HISTOGRAMS = 0,
+  METRICS_SECTION_DISCARDED,
+  METRICS_SECTION_COUNTERS,
+  METRICS_SECTION_GAUGES,
+  METRICS_SECTION_SENSOR,
+  METRICS_SECTION_COUNT
+} MetricsSection_t;
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+// Upper bound (inclusive) of each histogram bucket in microseconds. One
+// more overflow bucket (+Inf) follows the last one.
+const uint32_t BucketLimitsUs[METRICS_BUCKETS] = {
+  10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000
+};
+
+// Names used for the 'op' label, in MetricTimer_t order
+const char * const TimerNames[METRIC_TIMER_COUNT] = {
+  "json_parse",
+  "handler_temperature",
+  "handler_humidity",
+  "handler_pressure",
+  "handler_env",
+  "handler_led",
+  "handler_lcd",
+  "handler_icon",
+  "handler_state",
+  "handler_history",
+  "lcd_text",
+  "lcd_frame",
+  "led_show",
+  "led_transmit",
+  "sensor_read",
+  "sensor_i2c",
+  "log_write",
+  "first_pixel_ambient",
+  "first_pixel_advisory",
+  "first_pixel_watch",
+  "first_pixel_warning",
+};
+
+// Metric names and help text, in MetricCounter_t order
+const char * const CounterNames[METRIC_COUNTER_COUNT] = {
+  "iswam_http_requests_total",
+  "iswam_http_errors_total",
+  "iswam_loop_iterations_total",
+  "iswam_lcd_frames_total",
+  "iswam_lcd_lines_drawn_total",
+  "iswam_lcd_lines_skipped_total",
+  "iswam_raster_cache_hits_total",
+  "iswam_raster_cache_misses_total",
+  "iswam_raster_cache_evictions_total",
+  "iswam_raster_cache_refused_total",
+  "iswam_render_preemptions_total",
+  "iswam_wifi_disconnects_total",
+  "iswam_wifi_reconnects_total",
+  "iswam_sensor_read_errors_total",
+};
+const char * const CounterHelp[METRIC_COUNTER_COUNT] = {
+  "HTTP requests handled",
+  "HTTP requests answered with an error status",
+  "Arduino loop() iterations",
+  "Frames pushed to the LCD",
+  "Text lines sent to the LCD",
+  "Text lines not redrawn because they had not changed",
+  "Icons and text lines drawn from the raster cache",
+  "Icons and text lines that had to be rendered",
+  "Blocks evicted from the raster cache to make room",
+  "Blocks not cached because they had not been drawn recently",
+  "Times drawing stopped part way for a higher priority command",
+  "Times the connection to the access point was lost",
+  "Times the network came back after being lost",
+  "Sensor reads that failed, leaving the last sample in place",
+};
+
+Histogram_t Histograms[METRIC_TIMER_COUNT];
+std::atomic<uint32_t> Counters[METRIC_COUNTER_COUNT];
+
+// CPU clock, used to turn cycle counts into microseconds
+uint32_t CyclesPerUs = 240;
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+uint32_t metrics_Start(void)
+{
+  return ESP.getCycleCount();
+}
+
+// See header file for documentation block
+void metrics_Record(MetricTimer_t which, uint32_t startCycles, int startCore)
+{
+  uint32_t cycles = ESP.getCycleCount() - startCycles;
+  Histogram_t * histogram = &Histograms[which];
+
+  if (xPortGetCoreID() != startCore)
+  {
+    histogram->discarded.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  metrics_RecordUs(which, cycles / CyclesPerUs);
+}
+
+// See header file for documentation block
+void metrics_RecordUs(MetricTimer_t which, uint32_t us)
+{
+  Histogram_t * histogram = &Histograms[which];
+  int bucket = 0;
+
+  while (bucket < METRICS_BUCKETS && us > BucketLimitsUs[bucket])
+  {
+    bucket++;
+  }
+  histogram->buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  histogram->sumUs.fetch_add(us, std::memory_order_relaxed);
+}
+
+// See header file for documentation block
+void metrics_Increment(MetricCounter_t which)
+{
+  Counters[which].fetch_add(1, std::memory_order_relaxed);
+}
+
+// See header file for documentation block
+void metrics_Begin(MetricsCursor_t * cursor)
+{
+  memset(cursor, 0, sizeof(*cursor));
+}
+
+// See header file for documentation block
+size_t metrics_NextLine(MetricsCursor_t * cursor, char * line, size_t size)
+{
+  const int histogramLines = METRICS_BUCKETS + 3;   // Buckets, +Inf, sum and count
+  int n;
+  int i;
+  int row;
+  int written = 0;
+
+  // A section that runs out of lines moves on to the next one
+  while (written == 0 && cursor->section < METRICS_SECTION_COUNT)
+  {
+    n = cursor->line++;
+    switch (cursor->section)
+    {
+      case METRICS_SECTION_HISTOGRAMS:
+        if (n == 0)
+        {
+          written = snprintf(line, size, "# HELP iswam_op_duration_microseconds Time taken by instrumented operations\n");
+          break;
+        }
+        if (n == 1)
+        {
+          written = snprintf(line, size, "# TYPE iswam_op_duration_microseconds histogram\n");
+          break;
+        }
+        i = (n - 2) / histogramLines;
+        row = (n - 2) % histogramLines;
+        if (i >= METRIC_TIMER_COUNT)
+        {
+          break;
+        }
+        if (row == 0)
+        {
+          cursor->cumulative = 0;
+        }
+        if (row <= METRICS_BUCKETS)
+        {
+          cursor->cumulative += Histograms[i].buckets[row].load(std::memory_order_relaxed);
+        }
+        if (row < METRICS_BUCKETS)
+        {
+          written = snprintf(line, size, "iswam_op_duration_microseconds_bucket{op=\"%s\",le=\"%u\"} %u\n",
+            TimerNames[i], (unsigned)BucketLimitsUs[row], (unsigned)cursor->cumulative);
+        }
+        else if (row == METRICS_BUCKETS)
+        {
+          written = snprintf(line, size, "iswam_op_duration_microseconds_bucket{op=\"%s\",le=\"+Inf\"} %u\n",
+            TimerNames[i], (unsigned)cursor->cumulative);
+        }
+        else if (row == METRICS_BUCKETS + 1)
+        {
+          written = snprintf(line, size, "iswam_op_duration_microseconds_sum{op=\"%s\"} %llu\n",
+            TimerNames[i], (unsigned long long)Histograms[i].sumUs.load(std::memory_order_relaxed));
+        }
+        else
+        {
+          written = snprintf(line, size, "iswam_op_duration_microseconds_count{op=\"%s\"} %u\n",
+            TimerNames[i], (unsigned)cursor->cumulative);
+        }
+        break;
+
+      case METRICS_SECTION_DISCARDED:
+        if (n == 0)
+        {
+          written = snprintf(line, size, "# HELP iswam_op_samples_discarded_total Timings dropped because the task changed cores\n");
+        }
+        else if (n == 1)
+        {
+          written = snprintf(line, size, "# TYPE iswam_op_samples_discarded_total counter\n");
+        }
+        else if (n - 2 < METRIC_TIMER_COUNT)
+        {
+          written = snprintf(line, size, "iswam_op_samples_discarded_total{op=\"%s\"} %u\n",
+            TimerNames[n - 2], (unsigned)Histograms[n - 2].discarded.load(std::memory_order_relaxed));
+        }
+        break;
+
+      case METRICS_SECTION_COUNTERS:
+        i = n / 3;
+        row = n % 3;
+        if (i >= METRIC_COUNTER_COUNT)
+        {
+          break;
+        }
+        if (row == 0)
+        {
+          written = snprintf(line, size, "# HELP %s %s\n", CounterNames[i], CounterHelp[i]);
+        }
+        else if (row == 1)
+        {
+          written = snprintf(line, size, "# TYPE %s counter\n", CounterNames[i]);
+        }
+        else
+        {
+          written = snprintf(line, size, "%s %u\n", CounterNames[i], (unsigned)Counters[i].load(std::memory_order_relaxed));
+        }
+        break;
+
+      case METRICS_SECTION_GAUGES:
+        switch (n)
+        {
+          case 0:
+            written = snprintf(line, size, "# HELP iswam_log_dropped_total Log messages dropped because the log buffer was full\n");
+            break;
+          case 1:
+            written = snprintf(line, size, "# TYPE iswam_log_dropped_total counter\n");
+            break;
+          case 2:
+            written = snprintf(line, size, "iswam_log_dropped_total %u\n", (unsigned)logger_GetDropped());
+            break;
+          case 3:
+            written = snprintf(line, size, "# HELP iswam_raster_cache_bytes Bytes of pixels held in the raster cache\n");
+            break;
+          case 4:
+            written = snprintf(line, size, "# TYPE iswam_raster_cache_bytes gauge\n");
+            break;
+          case 5:
+            written = snprintf(line, size, "iswam_raster_cache_bytes %u\n", (unsigned)rastercache_GetBytes());
+            break;
+          case 6:
+            written = snprintf(line, size, "# HELP iswam_raster_cache_budget_bytes Most bytes the raster cache may hold\n");
+            break;
+          case 7:
+            written = snprintf(line, size, "# TYPE iswam_raster_cache_budget_bytes gauge\n");
+            break;
+          case 8:
+            written = snprintf(line, size, "iswam_raster_cache_budget_bytes %u\n", (unsigned)rastercache_GetBudget());
+            break;
+        }
+        break;
+
+      case METRICS_SECTION_SENSOR:
+        switch (n)
+        {
+          case 0:
+          {
+            // Both from the same sample, so a stuck sensor task shows as a growing age
+            SensorSnapshot_t sample;
+            sensor_GetSnapshot(&sample);
+            cursor->sensorSamples = sample.sequence;
+            cursor->sensorAgeMs = millis() - sample.timestampMs;
+            written = snprintf(line, size, "# HELP iswam_sensor_samples_total Sensor samples taken\n");
+            break;
+          }
+          case 1:
+            written = snprintf(line, size, "# TYPE iswam_sensor_samples_total counter\n");
+            break;
+          case 2:
+            written = snprintf(line, size, "iswam_sensor_samples_total %u\n", (unsigned)cursor->sensorSamples);
+            break;
+          case 3:
+            written = snprintf(line, size, "# HELP iswam_sensor_sample_age_ms Time since the latest sensor sample was taken\n");
+            break;
+          case 4:
+            written = snprintf(line, size, "# TYPE iswam_sensor_sample_age_ms gauge\n");
+            break;
+          case 5:
+            written = snprintf(line, size, "iswam_sensor_sample_age_ms %u\n", (unsigned)cursor->sensorAgeMs);
+            break;
+        }
+        break;
+    }
+
+    if (written == 0)
+    {
+      cursor->section++;
+      cursor->line = 0;
+    }
+  }
+  return (written > 0) ? min((size_t)written, size - 1) : 0;
+}
+
+// See header file for documentation block
+void metrics_Init(void)
+{
+  CyclesPerUs = getCpuFrequencyMhz();
+}
+
+// See header file for documentation block
+MetricsScope::MetricsScope(MetricTimer_t which)
+{
+  this->which = which;
+  startCore = xPortGetCoreID();
+  startCycles = metrics_Start();
+}
+
+// See header file for documentation block
+MetricsScope::~MetricsScope()
+{
+  metrics_Record(which, startCycles, startCore);
+}
\ No newline at end of file
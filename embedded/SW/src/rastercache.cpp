@@ -0,0 +1,266 @@
+/**
+  ******************************************************************************
+  * @file    rastercache.cpp
+  * @author  Brian Schmalz
+  * @brief   LRU cache of ready to draw pixel blocks (decoded icons and text lines)
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "rastercache.h"
+#include "metrics.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+// One cached block
+typedef struct {
+  RasterBlock_t block;
+  RasterKind_t kind;
+  uint16_t color;
+  uint32_t lastUse;             // UseClock when last found or inserted
+  uint32_t bytes;               // 0 if the entry is free
+  char key[RASTERCACHE_KEY_SIZE];
+} RasterEntry_t;
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+static RasterEntry_t Entries[RASTERCACHE_ENTRIES];
+
+// Bytes of pixels held by all entries, and most they may hold. Nothing is
+// cached until rastercache_Init() sets the budget.
+static uint32_t BytesUsed = 0;
+static uint32_t Budget = 0;
+
+// Where the pixels go: PSRAM if the board has it, else the normal heap
+static uint32_t PixelCaps = MALLOC_CAP_8BIT;
+
+// Counts up on every use, so the entry with the smallest lastUse is the
+// least recently used one
+static uint32_t UseClock = 0;
+
+// Hashes of the blocks most recently refused, oldest overwritten first
+static uint32_t Ghosts[RASTERCACHE_GHOSTS];
+static int NextGhost = 0;
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Free one entry
+  * @param  entry : Entry to free
+  * @retval none
+  */
+static void freeEntry(RasterEntry_t * entry)
+{
+  free(entry->block.pixels);
+  entry->block.pixels = NULL;
+  BytesUsed -= entry->bytes;
+  entry->bytes = 0;
+}
+
+/**
+  * @brief  Evict the least recently used entry
+  * @param  none
+  * @retval false if there was nothing left to evict
+  */
+static bool evictOldest(void)
+{
+  RasterEntry_t * oldest = NULL;
+
+  for (int i = 0; i < RASTERCACHE_ENTRIES; i++)
+  {
+    if (Entries[i].bytes != 0 && (oldest == NULL || Entries[i].lastUse < oldest->lastUse))
+    {
+      oldest = &Entries[i];
+    }
+  }
+  if (oldest == NULL)
+  {
+    return false;
+  }
+  freeEntry(oldest);
+  metrics_Increment(METRIC_RASTER_EVICTIONS);
+  return true;
+}
+
+/**
+  * @brief  Find a free entry
+  * @param  none
+  * @retval The entry, or NULL if all are in use
+  */
+static RasterEntry_t * freeSlot(void)
+{
+  for (int i = 0; i < RASTERCACHE_ENTRIES; i++)
+  {
+    if (Entries[i].bytes == 0)
+    {
+      return &Entries[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+  * @brief  Hash what a block is made from (FNV-1a)
+  * @param  kind : What the block is made from
+  * @param  key : Icon name or text
+  * @param  color : Color the block is drawn in
+  * @retval The hash, never 0 so empty ghosts never match
+  */
+static uint32_t hashKey(RasterKind_t kind, const char * key, uint16_t color)
+{
+  uint32_t hash = 2166136261UL ^ ((uint32_t)kind << 16 | color);
+
+  for (; *key != '\0'; key++)
+  {
+    hash = (hash ^ (uint8_t)*key) * 16777619UL;
+  }
+  return (hash == 0) ? 1 : hash;
+}
+
+/**
+  * @brief  Check whether a block was refused recently, and remember it if
+  *         it was not
+  * @param  hash : hashKey() of the block
+  * @retval true if it was refused within the last RASTERCACHE_GHOSTS inserts
+  */
+static bool seenRecently(uint32_t hash)
+{
+  for (int i = 0; i < RASTERCACHE_GHOSTS; i++)
+  {
+    if (Ghosts[i] == hash)
+    {
+      Ghosts[i] = 0;
+      return true;
+    }
+  }
+  Ghosts[NextGhost] = hash;
+  NextGhost = (NextGhost + 1) % RASTERCACHE_GHOSTS;
+  return false;
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+void rastercache_Init(void)
+{
+  if (psramFound())
+  {
+    Budget = RASTERCACHE_BUDGET;
+    PixelCaps = MALLOC_CAP_SPIRAM;
+  }
+  else
+  {
+    Budget = min(RASTERCACHE_BUDGET, RASTERCACHE_INTERNAL_BUDGET);
+    PixelCaps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+  }
+}
+
+// See header file for documentation block
+const RasterBlock_t * rastercache_Find(RasterKind_t kind, const char * key, uint16_t color)
+{
+  for (int i = 0; i < RASTERCACHE_ENTRIES; i++)
+  {
+    RasterEntry_t * entry = &Entries[i];
+    if (entry->bytes != 0 && entry->kind == kind && entry->color == color &&
+        strcmp(entry->key, key) == 0)
+    {
+      entry->lastUse = ++UseClock;
+      metrics_Increment(METRIC_RASTER_HITS);
+      return &entry->block;
+    }
+  }
+  metrics_Increment(METRIC_RASTER_MISSES);
+  return NULL;
+}
+
+// See header file for documentation block
+RasterBlock_t * rastercache_Insert(RasterKind_t kind, const char * key, uint16_t color,
+  int16_t width, int16_t height)
+{
+  uint32_t bytes = (uint32_t)width * height * sizeof(uint16_t);
+  RasterEntry_t * entry;
+
+  if (bytes == 0 || bytes > Budget || strlen(key) >= RASTERCACHE_KEY_SIZE)
+  {
+    return NULL;
+  }
+  if (!seenRecently(hashKey(kind, key, color)))
+  {
+    metrics_Increment(METRIC_RASTER_REFUSED);
+    return NULL;
+  }
+
+  while (BytesUsed + bytes > Budget)
+  {
+    evictOldest();
+  }
+  while ((entry = freeSlot()) == NULL)
+  {
+    evictOldest();
+  }
+
+  uint16_t * pixels = (uint16_t *)heap_caps_malloc(bytes, PixelCaps);
+  if (pixels == NULL)
+  {
+    return NULL;
+  }
+
+  entry->block.pixels = pixels;
+  entry->block.width = width;
+  entry->block.height = height;
+  entry->kind = kind;
+  entry->color = color;
+  entry->lastUse = ++UseClock;
+  entry->bytes = bytes;
+  strlcpy(entry->key, key, sizeof(entry->key));
+  BytesUsed += bytes;
+  return &entry->block;
+}
+
+// See header file for documentation block
+uint32_t rastercache_GetBytes(void)
+{
+  return BytesUsed;
+}
+
+// See header file for documentation block
+uint32_t rastercache_GetBudget(void)
+{
+  return Budget;
+}
\ No newline at end of file
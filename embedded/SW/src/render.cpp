@@ -0,0 +1,401 @@
+/**
+  ******************************************************************************
+  * @file    render.cpp
+  * @author  Brian Schmalz
+  * @brief   Display/LED render task
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <FreeRTOS.h>
+#include <esp_timer.h>
+#include "render.h"
+#include "lcd.h"
+#include "led.h"
+#include "logger.h"
+#include "metrics.h"
+#include "topology.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+// Everything one priority class currently wants shown
+typedef struct {
+  uint8_t parts;                // RENDER_PART_LCD/LED held (icons count as LCD)
+  uint8_t dirty;                // Parts changed since they were last shown
+  RenderLCD_t lcd;
+  RenderIcon_t icons[RENDER_MAX_ICONS];
+  int iconCount;
+  RenderLED_t led;
+  int64_t expiresUs;            // When to drop this content, 0 = never
+  int64_t pendingSinceUs;       // Submit time of the oldest unshown command, 0 if none
+} RenderLayer_t;
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+// Commands waiting for the render task, one queue per priority. NULL until
+// render_Init() is called.
+QueueHandle_t RenderQueues[RENDER_PRIORITY_COUNT];
+
+// Render task, notified whenever a command is queued
+TaskHandle_t RenderTask = NULL;
+
+// What each priority class wants shown
+RenderLayer_t Layers[RENDER_PRIORITY_COUNT];
+
+// Priority whose content is fully on the screen and LEDs, -1 if none (at
+// boot, or after drawing was preempted part way)
+int ShownLayer = -1;
+
+// Time to first pixel histogram of each priority class
+const MetricTimer_t FirstPixelTimers[RENDER_PRIORITY_COUNT] = {
+  METRIC_FIRST_PIXEL_AMBIENT,
+  METRIC_FIRST_PIXEL_ADVISORY,
+  METRIC_FIRST_PIXEL_WATCH,
+  METRIC_FIRST_PIXEL_WARNING,
+};
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Empty a layer
+  * @param  layer : Layer to empty
+  * @retval none
+  */
+void clearLayer(RenderLayer_t * layer)
+{
+  memset(layer, 0, sizeof(*layer));
+}
+
+/**
+  * @brief  Fold a command into the layer of its priority. Later commands
+  *         replace earlier ones part by part, so commands that are never
+  *         seen are skipped for free.
+  * @param  command : Command taken off a queue
+  * @retval none
+  */
+void mergeCommand(const RenderCommand_t * command)
+{
+  RenderLayer_t * layer = &Layers[command->priority];
+
+  if (command->parts & RENDER_PART_CLEAR)
+  {
+    clearLayer(layer);
+    return;
+  }
+
+  // A command that changes nothing must not extend the layer's duration
+  // or restart its first pixel timing
+  if (command->parts == 0)
+  {
+    return;
+  }
+
+  if (command->parts & RENDER_PART_LCD)
+  {
+    layer->lcd = command->lcd;
+    layer->iconCount = 0;
+    layer->parts |= RENDER_PART_LCD;
+    layer->dirty |= RENDER_PART_LCD;
+  }
+  if (command->parts & RENDER_PART_ICON)
+  {
+    // Keep the newest icons
+    if (layer->iconCount == RENDER_MAX_ICONS)
+    {
+      memmove(&layer->icons[0], &layer->icons[1], sizeof(RenderIcon_t) * (RENDER_MAX_ICONS - 1));
+      layer->iconCount--;
+    }
+    layer->icons[layer->iconCount++] = command->icon;
+    layer->parts |= RENDER_PART_LCD;
+    layer->dirty |= RENDER_PART_LCD;
+  }
+  if (command->parts & RENDER_PART_LED)
+  {
+    layer->led = command->led;
+    layer->parts |= RENDER_PART_LED;
+    layer->dirty |= RENDER_PART_LED;
+  }
+
+  layer->expiresUs = (command->durationMs != 0) ?
+    command->submittedUs + (int64_t)command->durationMs * 1000 : 0;
+  if (layer->pendingSinceUs == 0)
+  {
+    layer->pendingSinceUs = command->submittedUs;
+  }
+}
+
+/**
+  * @brief  Drop content whose duration has ended, then pick what to show
+  * @param  now : Current esp_timer time in microseconds
+  * @retval Highest priority with content, or ambient if none has any
+  */
+int activeLayer(int64_t now)
+{
+  int active = RENDER_PRIORITY_AMBIENT;
+
+  for (int p = 0; p < RENDER_PRIORITY_COUNT; p++)
+  {
+    if (Layers[p].expiresUs != 0 && now >= Layers[p].expiresUs)
+    {
+      clearLayer(&Layers[p]);
+    }
+    if (Layers[p].parts != 0)
+    {
+      active = p;
+    }
+  }
+  return active;
+}
+
+/**
+  * @brief  Work out how long the render task may sleep
+  * @param  now : Current esp_timer time in microseconds
+  * @retval Ticks until the next content expires, or portMAX_DELAY
+  */
+TickType_t ticksUntilExpiry(int64_t now)
+{
+  int64_t next = 0;
+
+  for (int p = 0; p < RENDER_PRIORITY_COUNT; p++)
+  {
+    if (Layers[p].expiresUs != 0 && (next == 0 || Layers[p].expiresUs < next))
+    {
+      next = Layers[p].expiresUs;
+    }
+  }
+  if (next == 0)
+  {
+    return portMAX_DELAY;
+  }
+  if (next <= now)
+  {
+    return 0;
+  }
+  return pdMS_TO_TICKS((next - now) / 1000) + 1;
+}
+
+/**
+  * @brief  Check if a command of higher priority is waiting
+  * @param  priority : Priority being drawn
+  * @retval true if drawing should stop so the waiting command goes first
+  */
+bool higherPending(int priority)
+{
+  for (int p = priority + 1; p < RENDER_PRIORITY_COUNT; p++)
+  {
+    if (uxQueueMessagesWaiting(RenderQueues[p]) > 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+  * @brief  Record the time to first pixel of a layer's newest content, the
+  *         first time any of it reaches the screen or LEDs
+  * @param  priority : Priority of the layer
+  * @retval none
+  */
+void firstPixel(int priority)
+{
+  RenderLayer_t * layer = &Layers[priority];
+
+  if (layer->pendingSinceUs != 0)
+  {
+    metrics_RecordUs(FirstPixelTimers[priority], esp_timer_get_time() - layer->pendingSinceUs);
+    layer->pendingSinceUs = 0;
+  }
+}
+
+/**
+  * @brief  Show a layer on the LCD and LEDs. Stops between steps (text,
+  *         each icon, LEDs) if a higher priority command arrives.
+  * @param  priority : Layer to show
+  * @param  full : true to draw everything, false for only what changed
+  * @retval true if the layer was shown completely, false if preempted
+  */
+bool showLayer(int priority, bool full)
+{
+  RenderLayer_t * layer = &Layers[priority];
+  uint8_t parts = full ? (RENDER_PART_LCD | RENDER_PART_LED) : layer->dirty;
+
+  if (parts & RENDER_PART_LCD)
+  {
+    bool preempted = false;
+
+    // Text and icons reach the panel together in one frame
+    lcd_BeginFrame();
+    lcd_printTextLines(layer->lcd.text[0], layer->lcd.text[1], layer->lcd.text[2], layer->lcd.text[3]);
+    for (int i = 0; i < layer->iconCount; i++)
+    {
+      if (higherPending(priority))
+      {
+        preempted = true;
+        break;
+      }
+      lcd_DrawIcon(layer->icons[i].name, layer->icons[i].x, layer->icons[i].y);
+    }
+    lcd_EndFrame();
+    firstPixel(priority);
+    if (preempted)
+    {
+      return false;
+    }
+  }
+
+  if (parts & RENDER_PART_LED)
+  {
+    if (higherPending(priority))
+    {
+      return false;
+    }
+
+    // Content without LED settings leaves the LEDs off
+    const RenderLED_t * led = &layer->led;
+    if (!(layer->parts & RENDER_PART_LED))
+    {
+      led_changeEffect(0, 0, 0, 0, 0, 0);
+    }
+    else
+    {
+      led_setFrameRate(led->fps);
+      if (led->severity != ANIM_SEVERITY_NONE)
+      {
+        led_changeSeverity(led->severity);
+      }
+      else
+      {
+        led_changeEffect(led->red, led->green, led->blue, led->effect, led->onTime, led->offTime);
+      }
+    }
+    firstPixel(priority);
+  }
+
+  layer->dirty = 0;
+  return true;
+}
+
+/**
+  * @brief  Render task. Waits for commands, folds them into the layer of
+  *         their priority and shows the highest priority layer on the LCD
+  *         and LEDs, so HTTP handlers never wait on SPI or NeoPixel timing.
+  * @param  parameter : ignored
+  * @retval none
+  */
+void RunRender(void * parameter)
+{
+  RenderCommand_t command;
+
+  for (;;)
+  {
+    // Sleep until a command is queued or some content expires
+    ulTaskNotifyTake(pdTRUE, ticksUntilExpiry(esp_timer_get_time()));
+
+    int merged = 0;
+    for (int p = RENDER_PRIORITY_COUNT - 1; p >= 0; p--)
+    {
+      while (xQueueReceive(RenderQueues[p], &command, 0) == pdTRUE)
+      {
+        mergeCommand(&command);
+        merged++;
+      }
+    }
+    if (merged > 1)
+    {
+      LOGGER_DEBUG("Render coalesced %d commands", merged);
+    }
+
+    int active = activeLayer(esp_timer_get_time());
+    bool full = (active != ShownLayer);
+    if (!full && Layers[active].dirty == 0)
+    {
+      continue;
+    }
+    if (full && ShownLayer > active)
+    {
+      LOGGER_INFO("Resuming priority %d content", active);
+    }
+
+    if (showLayer(active, full))
+    {
+      ShownLayer = active;
+    }
+    else
+    {
+      // The higher priority command is already queued, so the next pass
+      // comes straight away and starts over on a clean slate
+      ShownLayer = -1;
+      metrics_Increment(METRIC_RENDER_PREEMPTIONS);
+    }
+  }
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+bool render_Submit(const RenderCommand_t * command)
+{
+  RenderCommand_t stamped = *command;
+
+  if (stamped.priority >= RENDER_PRIORITY_COUNT || RenderTask == NULL)
+  {
+    return false;
+  }
+
+  stamped.submittedUs = esp_timer_get_time();
+  if (xQueueSend(RenderQueues[stamped.priority], &stamped, 0) != pdTRUE)
+  {
+    LOGGER_WARN("Render queue %d full", stamped.priority);
+    return false;
+  }
+  xTaskNotifyGive(RenderTask);
+  return true;
+}
+
+// See header file for documentation block
+void render_Init(void)
+{
+  for (int p = 0; p < RENDER_PRIORITY_COUNT; p++)
+  {
+    RenderQueues[p] = xQueueCreate(RENDER_QUEUE_DEPTH, sizeof(RenderCommand_t));
+    clearLayer(&Layers[p]);
+  }
+
+  topology_Create(TASK_RENDER, RunRender, NULL, &RenderTask);
+}
\ No newline at end of file
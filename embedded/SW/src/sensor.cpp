@@ -36,29 +36,78 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <FreeRTOS.h>
-#include <Adafruit_BME280.h>
-#include <Adafruit_Sensor.h>
+#include <Wire.h>
 #include "sensor.h"
+#include "seqlock.h"
+#include "bme280.h"
+#include "envcache.h"
+#include "history.h"
+#include "trend.h"
+#include "logger.h"
+#include "metrics.h"
+#include "topology.h"
 
 /* Private typedef -----------------------------------------------------------*/
 
 /* Private define ------------------------------------------------------------*/
 
+// Failed reads in a row before a reader sleeps for a tick, in case it has
+// preempted the sensor task in the middle of publishing
+#define SNAPSHOT_SPINS    16
+
+// Time between samples. Set with -DSENSOR_PERIOD_MS=... in build_flags.
+#ifndef SENSOR_PERIOD_MS
+#define SENSOR_PERIOD_MS      1000
+#endif
+
+// BME280 settings. Defaults follow the datasheet's weather monitoring
+// profile: one forced conversion per sample, 1x oversampling, no filter.
+// Override with build flags, e.g. -DSENSOR_MODE=BME280_MODE_NORMAL
+#define SENSOR_I2C_ADDRESS    0x76
+#ifndef SENSOR_I2C_CLOCK
+#define SENSOR_I2C_CLOCK      400000
+#endif
+#ifndef SENSOR_MODE
+#define SENSOR_MODE           BME280_MODE_FORCED
+#endif
+#ifndef SENSOR_OVERSAMPLE_T
+#define SENSOR_OVERSAMPLE_T   BME280_OVERSAMPLE_X1
+#endif
+#ifndef SENSOR_OVERSAMPLE_P
+#define SENSOR_OVERSAMPLE_P   BME280_OVERSAMPLE_X1
+#endif
+#ifndef SENSOR_OVERSAMPLE_H
+#define SENSOR_OVERSAMPLE_H   BME280_OVERSAMPLE_X1
+#endif
+#ifndef SENSOR_FILTER
+#define SENSOR_FILTER         BME280_FILTER_OFF
+#endif
+#ifndef SENSOR_STANDBY
+#define SENSOR_STANDBY        BME280_STANDBY_1000_MS
+#endif
+
 /* Private macro -------------------------------------------------------------*/
 
 /* Private variables ---------------------------------------------------------*/
 
-// Sensor variables
-/// NOTE: Using globals to share data with a task is not good practice (i.e. posible non-atomic access
-/// to the values).
-/// TODO: Switch to RTOS functions like message buffers to move data between tasks, or use semiphores
-/// to protect access to these globals
-float temperature;
-float humidity;
-float pressure;
+// Latest readings, shared with other tasks. The sensor task is the only
+// writer (sensor_Init() publishes before the task exists).
+static SeqLock<SensorSnapshot_t> Snapshot;
+
+// Readings served before the first sample (or without a sensor)
+const SensorSnapshot_t DefaultSnapshot = { 0.0f, 0.0f, 0.0f, 0, 0 };
 
 // Sensor
-Adafruit_BME280 bme;
+BME280 bme(Wire, SENSOR_I2C_ADDRESS);
+
+const BME280Config_t SensorConfig = {
+  SENSOR_MODE,
+  SENSOR_OVERSAMPLE_T,
+  SENSOR_OVERSAMPLE_P,
+  SENSOR_OVERSAMPLE_H,
+  SENSOR_FILTER,
+  SENSOR_STANDBY
+};
 
 // Set true if we intialized the sensor properly
 uint8_t UsingBME;
@@ -71,73 +120,108 @@ uint8_t UsingBME;
 /* Private functions ---------------------------------------------------------*/
 
 /**
-  * @brief  Sensor reading task. Runs continually. Read sensor every 60s.
+  * @brief  Sensor reading task. Runs continually. Read sensor every SENSOR_PERIOD_MS.
   * @param  parameter : ignored
   * @retval none
   */
 void readData(void * parameter) 
 {
+  SensorSnapshot_t sample = DefaultSnapshot;
+  TickType_t lastWake = xTaskGetTickCount();
+
   for (;;) 
   {
+    bool ok = true;
+
     if (UsingBME) 
     {
-      temperature = bme.readTemperature();
-      humidity = bme.readHumidity();
-      pressure = bme.readPressure() / 100;
+      BME280Sample_t raw;
+      {
+        MetricsScope timer(METRIC_SENSOR_READ);
+        ok = bme.read(&raw);
+      }
+      if (ok)
+      {
+        metrics_RecordUs(METRIC_SENSOR_I2C, raw.busUs);
+        sample.temperature = raw.temperature / 100.0f;
+        sample.humidity = raw.humidity / 1024.0f;
+        sample.pressure = raw.pressure / 25600.0f;    // Q24.8 Pa to mBar
+
+        // Fixed point copy for the history and statistics
+        HistorySample_t fixed;
+        fixed.timeMs = history_Now();
+        fixed.temperature = raw.temperature;
+        fixed.humidity = ((uint64_t)raw.humidity * 100 + 512) / 1024;
+        fixed.pressure = ((uint64_t)raw.pressure * 10 + 128) / 256;
+        history_Add(&fixed);
+        trend_Add(&fixed);
+      }
+      else
+      {
+        // Keep the last good sample, so its age on /metrics shows the
+        // sensor is stuck and clients don't get old values as new
+        metrics_Increment(METRIC_SENSOR_ERRORS);
+        LOGGER_ERROR("BME280 read failed");
+      }
+    }
+    if (ok)
+    {
+      sample.timestampMs = millis();
+      sample.sequence++;
+      Snapshot.write(sample);
+      LOGGER_DEBUG("Read sensor data: %.2f deg C %.2f %%RH %.2f mBar", sample.temperature, sample.humidity, sample.pressure);
+
+      // Build the HTTP responses once per sample rather than once per request
+      envcache_Publish(sample.temperature, sample.humidity, sample.pressure);
     }
-    Serial.print("Read sensor data: ");
-    Serial.print(temperature);
-    Serial.print(" deg F ");
-    Serial.print(humidity);
-    Serial.print(" %RH ");
-    Serial.print(pressure);
-    Serial.println(" mmHg");
-
-    // delay the task
-    vTaskDelay(60000 / portTICK_PERIOD_MS);
+
+    // Fixed rate, however long the read took
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(SENSOR_PERIOD_MS));
   }
 }
 
 /* Public functions ---------------------------------------------------------*/
 
 // See header file for documentation block
-float sensor_GetTemperature(void)
-{
-  return temperature;
-}
-
-// See header file for documentation block
-float sensor_GetHumidity(void)
+void sensor_GetSnapshot(SensorSnapshot_t * snapshot)
 {
-  return humidity;
-}
+  int spins = 0;
 
-// See header file for documentation block
-float sensor_GetPressure(void)
-{
-  return pressure;
+  while (!Snapshot.tryRead(snapshot))
+  {
+    if (++spins >= SNAPSHOT_SPINS)
+    {
+      vTaskDelay(1);
+      spins = 0;
+    }
+  }
 }
 
 // See header file for documentation block
 void sensor_Init(void)
 {
   // Sensor setup
-  if (!bme.begin(0x76)) 
+  Wire.begin();
+  Wire.setClock(SENSOR_I2C_CLOCK);
+  if (!bme.begin(SensorConfig)) 
   {
-    Serial.println("Problem connecting to BME280");
+    LOGGER_ERROR("Problem connecting to BME280");
     UsingBME = false;
+
+    // No samples will ever be taken, so serve the default readings
+    Snapshot.write(DefaultSnapshot);
+    envcache_Publish(DefaultSnapshot.temperature, DefaultSnapshot.humidity, DefaultSnapshot.pressure);
   }
   else 
   {
     UsingBME = true;
 
-    xTaskCreate(
-      readData,
-      "Read sensor data",   // Name of the task (for debugging)
-      4000,            // Stack size (bytes)
-      NULL,            // Parameter to pass
-      1,               // Task priority
-      NULL             // Task handle
-    );
+    if (!history_Init(SENSOR_PERIOD_MS))
+    {
+      LOGGER_ERROR("No memory for sample history");
+    }
+    trend_Init(SENSOR_PERIOD_MS);
+
+    topology_Create(TASK_SENSOR, readData, NULL, NULL);
   }
 }
@@ -0,0 +1,239 @@
+/**
+  ******************************************************************************
+  * @file    taskstats.cpp
+  * @author  Brian Schmalz
+  * @brief   Per-task CPU, stack and heap statistics
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <esp_heap_caps.h>
+#include "taskstats.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+// CPU shares come from the per-task run time counters, which only exist
+// when FreeRTOS is built with run time stats. Arduino-ESP32 links a
+// prebuilt FreeRTOS whose sdkconfig is expected to set both options below;
+// check that here so a framework without them stops the build instead of
+// quietly reporting every share as unknown.
+#if !defined(configGENERATE_RUN_TIME_STATS) || (configGENERATE_RUN_TIME_STATS != 1)
+#error "taskstats needs CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS in the framework's sdkconfig"
+#endif
+#if !defined(configUSE_TRACE_FACILITY) || (configUSE_TRACE_FACILITY != 1)
+#error "taskstats needs CONFIG_FREERTOS_USE_TRACE_FACILITY in the framework's sdkconfig"
+#endif
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+static const char * const WindowNames[TASKSTATS_WINDOW_COUNT] = { "5s", "60s" };
+
+// Length of each window in TASKSTATS_PERIOD_MS samples
+static const uint8_t WindowPeriods[TASKSTATS_WINDOW_COUNT] = { 1, 12 };
+
+static const char * const StateNames[] = { "running", "ready", "blocked", "suspended", "deleted" };
+
+// Ring of the last TASKSTATS_HISTORY samples, under TaskStatsMutex
+static TaskSnapshot_t TaskSnapshots[TASKSTATS_HISTORY];
+static uint32_t SnapshotCount = 0;     // Samples taken since boot
+static SemaphoreHandle_t TaskStatsMutex = NULL;
+
+// When the last sample was taken, and room to read the tasks into.
+// Only the loop task uses these.
+static uint32_t LastSampleMs = 0;
+static TaskStatus_t SampleTasks[TASKSTATS_MAX_TASKS];
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Run time of a task in a sample
+  * @param  snapshot : the sample
+  * @param  number : the task's xTaskNumber
+  * @param  runTime : filled in with the task's run time
+  * @retval true if the task was in the sample
+  */
+static bool findRunTime(const TaskSnapshot_t * snapshot, UBaseType_t number, uint32_t * runTime)
+{
+  for (int i = 0; i < snapshot->count; i++)
+  {
+    if (snapshot->number[i] == number)
+    {
+      *runTime = snapshot->runTime[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+void taskstats_Init(void)
+{
+  TaskStatsMutex = xSemaphoreCreateMutex();
+}
+
+// See header file for documentation block
+void taskstats_Sample(void)
+{
+  uint32_t now = millis();
+  uint32_t totalRunTime;
+
+  if (SnapshotCount > 0 && now - LastSampleMs < TASKSTATS_PERIOD_MS)
+  {
+    return;
+  }
+  LastSampleMs = now;
+
+  UBaseType_t count = uxTaskGetSystemState(SampleTasks, TASKSTATS_MAX_TASKS, &totalRunTime);
+  if (count == 0)
+  {
+    return;
+  }
+
+  xSemaphoreTake(TaskStatsMutex, portMAX_DELAY);
+  TaskSnapshot_t * snapshot = &TaskSnapshots[SnapshotCount % TASKSTATS_HISTORY];
+  for (UBaseType_t i = 0; i < count; i++)
+  {
+    snapshot->number[i] = SampleTasks[i].xTaskNumber;
+    snapshot->runTime[i] = SampleTasks[i].ulRunTimeCounter;
+  }
+  snapshot->count = count;
+  snapshot->totalRunTime = totalRunTime;
+  snapshot->timeUs = esp_timer_get_time();
+  SnapshotCount++;
+  xSemaphoreGive(TaskStatsMutex);
+}
+
+// See header file for documentation block
+bool taskstats_Begin(TaskStatsQuery_t * query)
+{
+  uint32_t totalRunTime = 0;
+
+  query->count = uxTaskGetSystemState(query->tasks, TASKSTATS_MAX_TASKS, &totalRunTime);
+  query->totalRunTime = totalRunTime;
+  query->timeUs = esp_timer_get_time();
+  query->next = 0;
+  if (query->count == 0)
+  {
+    return false;
+  }
+  // The core comes from the read itself rather than from the handle: a
+  // boot task may end and be freed by the idle task before this runs
+  for (int i = 0; i < query->count; i++)
+  {
+#if defined(configTASKLIST_INCLUDE_COREID) && (configTASKLIST_INCLUDE_COREID == 1)
+    BaseType_t core = query->tasks[i].xCoreID;
+    query->core[i] = (core == tskNO_AFFINITY) ? -1 : core;
+#else
+    query->core[i] = -1;
+#endif
+  }
+
+  // Each window starts at the newest sample at least that old, or at boot
+  xSemaphoreTake(TaskStatsMutex, portMAX_DELAY);
+  for (int w = 0; w < TASKSTATS_WINDOW_COUNT; w++)
+  {
+    if (SnapshotCount > WindowPeriods[w])
+    {
+      query->base[w] = TaskSnapshots[(SnapshotCount - 1 - WindowPeriods[w]) % TASKSTATS_HISTORY];
+    }
+    else
+    {
+      memset(&query->base[w], 0, sizeof(query->base[w]));
+    }
+  }
+  xSemaphoreGive(TaskStatsMutex);
+  return true;
+}
+
+// See header file for documentation block
+bool taskstats_Next(TaskStatsQuery_t * query, TaskStatsRow_t * row)
+{
+  if (query->next >= query->count)
+  {
+    return false;
+  }
+  int i = query->next++;
+  const TaskStatus_t * task = &query->tasks[i];
+
+  row->name = task->pcTaskName;
+  row->state = (task->eCurrentState <= eDeleted) ? StateNames[task->eCurrentState] : "unknown";
+  row->priority = task->uxCurrentPriority;
+  row->core = query->core[i];
+  row->stackFree = task->usStackHighWaterMark;
+
+  for (int w = 0; w < TASKSTATS_WINDOW_COUNT; w++)
+  {
+    const TaskSnapshot_t * base = &query->base[w];
+    uint32_t total = query->totalRunTime - base->totalRunTime;
+    uint32_t before = 0;
+
+    row->cpu[w] = -1.0f;
+    if (total > 0)
+    {
+      // A task missing from the base sample started after it
+      findRunTime(base, task->xTaskNumber, &before);
+      row->cpu[w] = 100.0f * (float)(task->ulRunTimeCounter - before) / (float)total;
+    }
+  }
+  return true;
+}
+
+// See header file for documentation block
+uint32_t taskstats_GetWindowMs(const TaskStatsQuery_t * query, int window)
+{
+  return (uint32_t)((query->timeUs - query->base[window].timeUs) / 1000);
+}
+
+// See header file for documentation block
+const char * taskstats_GetWindowName(int window)
+{
+  return WindowNames[window];
+}
+
+// See header file for documentation block
+void taskstats_GetHeap(TaskHeapStats_t * heap)
+{
+  heap->free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  heap->minFree = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  heap->largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  heap->fragmentation = heap->free ? 1.0f - (float)heap->largestBlock / (float)heap->free : 0.0f;
+}
\ No newline at end of file
@@ -0,0 +1,177 @@
+/**
+  ******************************************************************************
+  * @file    topology.cpp
+  * @author  Brian Schmalz
+  * @brief   Task placement, priorities and stack budgets
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <FreeRTOS.h>
+#include "topology.h"
+#include "logger.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+typedef struct {
+  const char * name;
+  uint32_t stackSize;           // Bytes
+  UBaseType_t priority;
+  BaseType_t core;
+} TaskConfig_t;
+
+/* Private define ------------------------------------------------------------*/
+
+// Tasks created by libraries and the Arduino core that are checked too
+#define TOPOLOGY_EXTERNAL_COUNT 3
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/// NOTE: The LED task has the highest priority on its core so frames go out
+/// on time, and the render task comes next. On core 0 the WiFi driver (23),
+/// lwIP (18) and AsyncTCP (3) all outrank our tasks, so a sensor sample or
+/// log write never holds up a request. The boot tasks only live until
+/// their init function returns.
+static const TaskConfig_t TaskTable[TASK_ID_COUNT] = {
+  //  name                 stack  priority  core
+  { "Log drain",           2048,  0,        TOPOLOGY_NETWORK_CORE },
+  { "Read sensor data",    4096,  2,        TOPOLOGY_NETWORK_CORE },
+  { "WiFi",                4096,  1,        TOPOLOGY_NETWORK_CORE },
+  { "Render",              4096,  2,        TOPOLOGY_RENDER_CORE },
+  { "LED Effects",         2048,  3,        TOPOLOGY_RENDER_CORE },
+  { "Boot LCD",            4096,  1,        TOPOLOGY_RENDER_CORE },
+  { "Boot LED",            2048,  1,        TOPOLOGY_RENDER_CORE },
+  { "Boot sensor",         6144,  1,        TOPOLOGY_NETWORK_CORE },
+};
+
+static const char * const ExternalTasks[TOPOLOGY_EXTERNAL_COUNT] = {
+  "loopTask", "async_tcp", "arduino_events"
+};
+
+// Running tasks, NULL once they have ended. Changed under TopologyLock.
+static TaskHandle_t TaskHandles[TASK_ID_COUNT];
+static bool TaskEnded[TASK_ID_COUNT];
+static portMUX_TYPE TopologyLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Tasks that have already been warned about
+static bool StackWarned[TASK_ID_COUNT];
+static bool ExternalWarned[TOPOLOGY_EXTERNAL_COUNT];
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Warn once if a task is close to running out of stack
+  * @param  name : task name
+  * @param  freeBytes : stack the task has never used
+  * @param  warned : set once the task has been warned about
+  * @retval none
+  */
+static void checkStack(const char * name, uint32_t freeBytes, bool * warned)
+{
+  if (freeBytes < TOPOLOGY_STACK_MARGIN && !*warned)
+  {
+    LOGGER_WARN("Task %s has only %u bytes of stack left", name, (unsigned)freeBytes);
+    *warned = true;
+  }
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+bool topology_Create(TaskId_t id, TaskFunction_t function, void * parameter, TaskHandle_t * handle)
+{
+  const TaskConfig_t * config = &TaskTable[id];
+  TaskHandle_t created = NULL;
+
+  // The caller's handle is filled in before the task first runs
+  if (handle == NULL)
+  {
+    handle = &created;
+  }
+  if (xTaskCreatePinnedToCore(function, config->name, config->stackSize, parameter, config->priority,
+                              handle, config->core) != pdPASS)
+  {
+    LOGGER_ERROR("Could not create task %s", config->name);
+    return false;
+  }
+
+  // A task on the other core may already have run and ended
+  portENTER_CRITICAL(&TopologyLock);
+  if (!TaskEnded[id])
+  {
+    TaskHandles[id] = *handle;
+  }
+  portEXIT_CRITICAL(&TopologyLock);
+  return true;
+}
+
+// See header file for documentation block
+void topology_Exit(TaskId_t id)
+{
+  portENTER_CRITICAL(&TopologyLock);
+  TaskHandles[id] = NULL;
+  TaskEnded[id] = true;
+  portEXIT_CRITICAL(&TopologyLock);
+  vTaskDelete(NULL);
+}
+
+// See header file for documentation block
+void topology_CheckStacks(void)
+{
+  for (int id = 0; id < TASK_ID_COUNT; id++)
+  {
+    uint32_t freeBytes = UINT32_MAX;
+
+    portENTER_CRITICAL(&TopologyLock);
+    if (TaskHandles[id] != NULL)
+    {
+      freeBytes = uxTaskGetStackHighWaterMark(TaskHandles[id]);
+    }
+    portEXIT_CRITICAL(&TopologyLock);
+
+    checkStack(TaskTable[id].name, freeBytes, &StackWarned[id]);
+  }
+
+  // These are never deleted
+  for (int i = 0; i < TOPOLOGY_EXTERNAL_COUNT; i++)
+  {
+    TaskHandle_t handle = xTaskGetHandle(ExternalTasks[i]);
+    if (handle != NULL)
+    {
+      checkStack(ExternalTasks[i], uxTaskGetStackHighWaterMark(handle), &ExternalWarned[i]);
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,614 @@
+/**
+  ******************************************************************************
+  * @file    trend.cpp
+  * @author  Brian Schmalz
+  * @brief   Rolling sensor statistics and local alert rules
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <math.h>
+#include "trend.h"
+#include "render.h"
+#include "anim.h"
+#include "logger.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+// Which statistic a rule looks at
+typedef enum {
+  TREND_STAT_MIN = 0,
+  TREND_STAT_MAX,
+  TREND_STAT_MEAN,
+  TREND_STAT_SLOPE,
+  TREND_STAT_EWMA
+} TrendStat_t;
+
+/**
+  * @brief  An alert rule: raised when a statistic passes 'trigger', cleared
+  *         when it comes back past 'release' (the gap stops it flickering)
+  */
+typedef struct {
+  const char * name;            // Reported on /env?stats=1 while raised
+  uint8_t channel;              // TrendChannel_t
+  uint8_t window;               // TrendWindow_t (not used for TREND_STAT_EWMA)
+  uint8_t stat;                 // TrendStat_t
+  bool below;                   // Raise when the statistic is below (true) or above trigger
+  float trigger;
+  float release;
+  uint16_t minMinutes;          // Minutes of data needed before the rule is checked
+  uint8_t priority;             // RenderPriority_t of the alert
+  uint8_t severity;             // AnimSeverity_t LED preset of the alert
+  const char * text;            // Second LCD line, followed by the statistic
+} TrendRule_t;
+
+// Queue of minute positions whose values only get worse towards the back,
+// so the front is the min (or max) of the window
+typedef struct {
+  uint16_t * slots;
+  uint16_t capacity;
+  uint16_t head;
+  uint16_t count;
+} TrendQueue_t;
+
+// Running state of one window
+typedef struct {
+  uint16_t size;                // Closed minutes kept (the current minute makes up the rest)
+  uint16_t n;                   // Minutes with samples in the window
+  int64_t sumX;                 // Sums over those minutes of x (minute number),
+  int64_t sumXX;                // x squared, y (minute mean) and x * y
+  int64_t sumY[TREND_CHANNELS];
+  int64_t sumXY[TREND_CHANNELS];
+  TrendQueue_t minQueue[TREND_CHANNELS];
+  TrendQueue_t maxQueue[TREND_CHANNELS];
+} TrendWindowState_t;
+
+// One closed minute
+typedef struct {
+  int32_t mean[TREND_CHANNELS];
+  int32_t min[TREND_CHANNELS];
+  int32_t max[TREND_CHANNELS];
+} TrendMinute_t;
+
+/* Private define ------------------------------------------------------------*/
+
+// Closed minute ring. Longer than any window's closed minutes, so a minute
+// leaving a window has not been overwritten yet.
+#define TREND_RING              TREND_MAX_WINDOW
+
+// EWMA time constant. Set with -DTREND_EWMA_TAU_S=... in build_flags.
+#ifndef TREND_EWMA_TAU_S
+#define TREND_EWMA_TAU_S        600
+#endif
+
+// A raised alert is resent this often, each time lasting TREND_ALERT_HOLD_MS,
+// so it goes away by itself within TREND_ALERT_HOLD_MS of the rule clearing
+#define TREND_ALERT_REFRESH_MS  (10 * 60 * 1000)
+#define TREND_ALERT_HOLD_MS     (15 * 60 * 1000)
+
+// Pressure falls (mBar/hour) that raise the storm alerts. 6 mBar in 3 hours
+// is what WMO calls falling quickly. Override with build flags.
+#ifndef TREND_FALL_3H
+#define TREND_FALL_3H           -2.0f
+#endif
+#ifndef TREND_FALL_1H
+#define TREND_FALL_1H           -4.0f
+#endif
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+const TrendRule_t Rules[] = {
+  { "pressure_fall_3h", TREND_PRESSURE, TREND_WINDOW_3H, TREND_STAT_SLOPE, true,
+    TREND_FALL_3H, TREND_FALL_3H * 0.5f, 90, RENDER_PRIORITY_WATCH, ANIM_SEVERITY_WATCH,
+    "Pressure falling" },
+  { "pressure_fall_1h", TREND_PRESSURE, TREND_WINDOW_1H, TREND_STAT_SLOPE, true,
+    TREND_FALL_1H, TREND_FALL_1H * 0.5f, 30, RENDER_PRIORITY_WARNING, ANIM_SEVERITY_WARNING,
+    "Pressure dropping fast" },
+};
+#define RULE_COUNT (sizeof(Rules) / sizeof(Rules[0]))
+static_assert(RULE_COUNT <= TREND_MAX_RULES, "too many trend rules");
+
+const uint16_t WindowMinutes[TREND_WINDOW_COUNT] = { 60, 180, 360 };
+const char * const WindowNames[TREND_WINDOW_COUNT] = { "1h", "3h", "6h" };
+static_assert(360 == TREND_MAX_WINDOW, "longest window must match TREND_MAX_WINDOW");
+
+// Fixed point scale of each channel in a TsSample_t
+const float ChannelScale[TREND_CHANNELS] = { 100.0f, 100.0f, 1000.0f };
+
+// Closed minutes, by minute number % TREND_RING
+static TrendMinute_t Minutes[TREND_RING];
+static bool MinuteValid[TREND_RING];
+
+// Queue slots for every window's min and max queues
+static uint16_t QueueSlots[2 * TREND_CHANNELS * (59 + 179 + 359)];
+
+static TrendWindowState_t Windows[TREND_WINDOW_COUNT];
+
+// Minute being filled: its number (minutes closed since the last reset),
+// the wall clock minute it covers and its running sums
+static uint32_t MinuteNumber;
+static int64_t MinuteClock;
+static int64_t MinuteSum[TREND_CHANNELS];
+static int32_t MinuteMin[TREND_CHANNELS];
+static int32_t MinuteMax[TREND_CHANNELS];
+static uint16_t MinuteCount;
+
+static float Ewma[TREND_CHANNELS];
+static float EwmaAlpha;
+static uint32_t SampleCount;
+
+// Alert rule state
+static bool RuleActive[RULE_COUNT];
+static uint32_t RuleSentMs[RULE_COUNT];
+static bool RuleSent[RULE_COUNT];
+
+// Statistics as of the latest sample, copied out under StatsLock
+static TrendStats_t Published;
+static portMUX_TYPE StatsLock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Remove everything from a queue
+  * @param  queue : the queue
+  * @retval none
+  */
+static void queueClear(TrendQueue_t * queue)
+{
+  queue->head = 0;
+  queue->count = 0;
+}
+
+/**
+  * @brief  Minute position at the front (oldest end) of a queue
+  * @param  queue : a queue that is not empty
+  * @retval ring position
+  */
+static uint16_t queueFront(const TrendQueue_t * queue)
+{
+  return queue->slots[queue->head];
+}
+
+/**
+  * @brief  Minute position at the back (newest end) of a queue
+  * @param  queue : a queue that is not empty
+  * @retval ring position
+  */
+static uint16_t queueBack(const TrendQueue_t * queue)
+{
+  return queue->slots[(queue->head + queue->count - 1) % queue->capacity];
+}
+
+/**
+  * @brief  Add a minute to a min (or max) queue, first dropping the minutes
+  *         at the back it beats, as they can never be the min (max) again
+  * @param  queue : the queue
+  * @param  position : ring position of the new minute
+  * @param  channel : channel the queue is for
+  * @param  isMax : true for a max queue
+  * @retval none
+  */
+static void queuePush(TrendQueue_t * queue, uint16_t position, int channel, bool isMax)
+{
+  while (queue->count > 0)
+  {
+    const TrendMinute_t * back = &Minutes[queueBack(queue)];
+    const TrendMinute_t * added = &Minutes[position];
+    bool beaten = isMax ? (back->max[channel] <= added->max[channel])
+                        : (back->min[channel] >= added->min[channel]);
+    if (!beaten)
+    {
+      break;
+    }
+    queue->count--;
+  }
+  queue->slots[(queue->head + queue->count) % queue->capacity] = position;
+  queue->count++;
+}
+
+/**
+  * @brief  Drop minutes that have left the window from the front of a queue
+  * @param  queue : the queue
+  * @param  newest : ring position of the newest minute
+  * @param  size : window length in minutes
+  * @retval none
+  */
+static void queueExpire(TrendQueue_t * queue, uint16_t newest, uint16_t size)
+{
+  while (queue->count > 0 &&
+         (newest + TREND_RING - queueFront(queue)) % TREND_RING >= size)
+  {
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+  }
+}
+
+/**
+  * @brief  Start the current minute afresh
+  * @retval none
+  */
+static void resetMinute(void)
+{
+  MinuteCount = 0;
+  for (int c = 0; c < TREND_CHANNELS; c++)
+  {
+    MinuteSum[c] = 0;
+    MinuteMin[c] = INT32_MAX;
+    MinuteMax[c] = INT32_MIN;
+  }
+}
+
+/**
+  * @brief  Forget all minutes (start up, or a gap or clock change longer
+  *         than the longest window)
+  * @retval none
+  */
+static void resetAll(void)
+{
+  memset(MinuteValid, 0, sizeof(MinuteValid));
+  for (int w = 0; w < TREND_WINDOW_COUNT; w++)
+  {
+    TrendWindowState_t * window = &Windows[w];
+    window->n = 0;
+    window->sumX = 0;
+    window->sumXX = 0;
+    for (int c = 0; c < TREND_CHANNELS; c++)
+    {
+      window->sumY[c] = 0;
+      window->sumXY[c] = 0;
+      queueClear(&window->minQueue[c]);
+      queueClear(&window->maxQueue[c]);
+    }
+  }
+  MinuteNumber = 0;
+  SampleCount = 0;
+  resetMinute();
+}
+
+/**
+  * @brief  Add or remove one minute's point from a window's running sums
+  * @param  window : the window
+  * @param  number : minute number (the x of the point)
+  * @param  minute : the minute (its means are the y of the point)
+  * @param  sign : 1 to add, -1 to remove
+  * @retval none
+  */
+static void updateSums(TrendWindowState_t * window, uint32_t number, const TrendMinute_t * minute, int sign)
+{
+  int64_t x = number;
+
+  window->n += sign;
+  window->sumX += sign * x;
+  window->sumXX += sign * x * x;
+  for (int c = 0; c < TREND_CHANNELS; c++)
+  {
+    window->sumY[c] += sign * (int64_t)minute->mean[c];
+    window->sumXY[c] += sign * x * minute->mean[c];
+  }
+}
+
+/**
+  * @brief  Close the current minute (possibly empty) and slide every window
+  *         on by one minute
+  * @retval none
+  */
+static void closeMinute(void)
+{
+  uint16_t position = MinuteNumber % TREND_RING;
+  TrendMinute_t * minute = &Minutes[position];
+  bool valid = (MinuteCount > 0);
+
+  // Take the minutes leaving each window out of its sums
+  for (int w = 0; w < TREND_WINDOW_COUNT; w++)
+  {
+    TrendWindowState_t * window = &Windows[w];
+    if (MinuteNumber >= window->size)
+    {
+      uint32_t leaving = MinuteNumber - window->size;
+      if (MinuteValid[leaving % TREND_RING])
+      {
+        updateSums(window, leaving, &Minutes[leaving % TREND_RING], -1);
+      }
+    }
+  }
+
+  MinuteValid[position] = valid;
+  if (valid)
+  {
+    for (int c = 0; c < TREND_CHANNELS; c++)
+    {
+      minute->mean[c] = MinuteSum[c] / MinuteCount;
+      minute->min[c] = MinuteMin[c];
+      minute->max[c] = MinuteMax[c];
+    }
+  }
+
+  for (int w = 0; w < TREND_WINDOW_COUNT; w++)
+  {
+    TrendWindowState_t * window = &Windows[w];
+    for (int c = 0; c < TREND_CHANNELS; c++)
+    {
+      queueExpire(&window->minQueue[c], position, window->size);
+      queueExpire(&window->maxQueue[c], position, window->size);
+      if (valid)
+      {
+        queuePush(&window->minQueue[c], position, c, false);
+        queuePush(&window->maxQueue[c], position, c, true);
+      }
+    }
+    if (valid)
+    {
+      updateSums(window, MinuteNumber, minute, 1);
+    }
+  }
+
+  MinuteNumber++;
+  resetMinute();
+}
+
+/**
+  * @brief  Work out one channel's statistics over one window, counting the
+  *         current minute so far as the newest point
+  * @param  window : the window
+  * @param  c : the channel
+  * @param  stats : filled in with the statistics
+  * @retval none
+  */
+static void windowStats(const TrendWindowState_t * window, int c, TrendWindowStats_t * stats)
+{
+  int64_t n = window->n;
+  int64_t sumX = window->sumX;
+  int64_t sumXX = window->sumXX;
+  int64_t sumY = window->sumY[c];
+  int64_t sumXY = window->sumXY[c];
+  int32_t low = INT32_MAX;
+  int32_t high = INT32_MIN;
+
+  if (window->minQueue[c].count > 0)
+  {
+    low = Minutes[queueFront(&window->minQueue[c])].min[c];
+    high = Minutes[queueFront(&window->maxQueue[c])].max[c];
+  }
+  if (MinuteCount > 0)
+  {
+    int64_t x = MinuteNumber;
+    int64_t y = MinuteSum[c] / MinuteCount;
+    n++;
+    sumX += x;
+    sumXX += x * x;
+    sumY += y;
+    sumXY += x * y;
+    low = min(low, MinuteMin[c]);
+    high = max(high, MinuteMax[c]);
+  }
+
+  stats->minutes = n;
+  stats->min = (n > 0) ? low / ChannelScale[c] : 0;
+  stats->max = (n > 0) ? high / ChannelScale[c] : 0;
+  stats->mean = (n > 0) ? (float)sumY / n / ChannelScale[c] : 0;
+  stats->slope = 0;
+  if (n >= 2)
+  {
+    int64_t numerator = n * sumXY - sumX * sumY;
+    int64_t denominator = n * sumXX - sumX * sumX;
+    if (denominator != 0)
+    {
+      // Per minute in fixed point, to per hour in channel units
+      stats->slope = (float)((double)numerator / denominator) * 60 / ChannelScale[c];
+    }
+  }
+}
+
+/**
+  * @brief  Send a rule's alert to the render task
+  * @param  rule : the rule
+  * @param  value : the statistic that raised it
+  * @retval true if it was queued
+  */
+static bool sendAlert(const TrendRule_t * rule, float value)
+{
+  RenderCommand_t command;
+
+  memset(&command, 0, sizeof(command));
+  command.parts = RENDER_PART_LCD | RENDER_PART_LED;
+  command.priority = rule->priority;
+  command.durationMs = TREND_ALERT_HOLD_MS;
+  command.led.severity = rule->severity;
+  strlcpy(command.lcd.text[0], "Local alert", RENDER_TEXT_SIZE);
+  strlcpy(command.lcd.text[1], rule->text, RENDER_TEXT_SIZE);
+  if (rule->stat == TREND_STAT_SLOPE)
+  {
+    snprintf(command.lcd.text[2], RENDER_TEXT_SIZE, "%.1f/h over %s", value, WindowNames[rule->window]);
+  }
+  else
+  {
+    snprintf(command.lcd.text[2], RENDER_TEXT_SIZE, "%.1f", value);
+  }
+  return render_Submit(&command);
+}
+
+/**
+  * @brief  Check every rule against the latest statistics, raising alerts
+  *         for rules that have become true and refreshing raised ones
+  * @param  stats : the latest statistics
+  * @retval bit mask of raised rules
+  */
+static uint32_t checkRules(const TrendStats_t * stats)
+{
+  uint32_t active = 0;
+  uint32_t now = millis();
+
+  for (size_t r = 0; r < RULE_COUNT; r++)
+  {
+    const TrendRule_t * rule = &Rules[r];
+    const TrendChannelStats_t * channel = &stats->channel[rule->channel];
+    const TrendWindowStats_t * window = &channel->window[rule->window];
+    float value;
+
+    switch (rule->stat)
+    {
+      case TREND_STAT_MIN:   value = window->min;   break;
+      case TREND_STAT_MAX:   value = window->max;   break;
+      case TREND_STAT_MEAN:  value = window->mean;  break;
+      case TREND_STAT_SLOPE: value = window->slope; break;
+      default:               value = channel->ewma; break;
+    }
+
+    bool enough = (rule->stat == TREND_STAT_EWMA) || (window->minutes >= rule->minMinutes);
+    float limit = RuleActive[r] ? rule->release : rule->trigger;
+    bool past = rule->below ? (value <= limit) : (value >= limit);
+
+    if (enough && past && !RuleActive[r])
+    {
+      LOGGER_WARN("Trend rule %s raised: %.2f", rule->name, value);
+      RuleActive[r] = true;
+      RuleSent[r] = false;
+    }
+    else if (RuleActive[r] && !(enough && past))
+    {
+      LOGGER_INFO("Trend rule %s cleared: %.2f", rule->name, value);
+      RuleActive[r] = false;
+    }
+
+    // Resend until the render task takes it, then every refresh period
+    if (RuleActive[r])
+    {
+      active |= 1UL << r;
+      if ((!RuleSent[r] || now - RuleSentMs[r] >= TREND_ALERT_REFRESH_MS) && sendAlert(rule, value))
+      {
+        RuleSent[r] = true;
+        RuleSentMs[r] = now;
+      }
+    }
+  }
+  return active;
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+void trend_Init(uint32_t periodMs)
+{
+  uint16_t * slots = QueueSlots;
+
+  for (int w = 0; w < TREND_WINDOW_COUNT; w++)
+  {
+    // A window is the current minute plus the closed minutes before it
+    Windows[w].size = WindowMinutes[w] - 1;
+    for (int c = 0; c < TREND_CHANNELS; c++)
+    {
+      Windows[w].minQueue[c].slots = slots;
+      Windows[w].minQueue[c].capacity = Windows[w].size;
+      slots += Windows[w].size;
+      Windows[w].maxQueue[c].slots = slots;
+      Windows[w].maxQueue[c].capacity = Windows[w].size;
+      slots += Windows[w].size;
+    }
+  }
+  EwmaAlpha = 1.0f - expf(-(float)periodMs / (TREND_EWMA_TAU_S * 1000.0f));
+  resetAll();
+}
+
+// See header file for documentation block
+void trend_Add(const TsSample_t * sample)
+{
+  int32_t value[TREND_CHANNELS] = { sample->temperature, sample->humidity, sample->pressure };
+  int64_t clock = sample->timeMs / 60000;
+  TrendStats_t stats;
+
+  // Move on to the sample's minute, closing the minutes in between. A gap
+  // longer than the longest window, or the clock going back, starts over.
+  if (SampleCount == 0 || clock < MinuteClock || clock - MinuteClock > TREND_MAX_WINDOW)
+  {
+    if (SampleCount != 0)
+    {
+      LOGGER_INFO("Trend statistics reset after a clock jump or gap");
+    }
+    resetAll();
+    MinuteClock = clock;
+  }
+  while (MinuteClock < clock)
+  {
+    closeMinute();
+    MinuteClock++;
+  }
+
+  for (int c = 0; c < TREND_CHANNELS; c++)
+  {
+    MinuteSum[c] += value[c];
+    MinuteMin[c] = min(MinuteMin[c], value[c]);
+    MinuteMax[c] = max(MinuteMax[c], value[c]);
+    Ewma[c] = (SampleCount == 0) ? value[c] / ChannelScale[c]
+                                 : Ewma[c] + EwmaAlpha * (value[c] / ChannelScale[c] - Ewma[c]);
+  }
+  MinuteCount++;
+  SampleCount++;
+
+  for (int c = 0; c < TREND_CHANNELS; c++)
+  {
+    stats.channel[c].ewma = Ewma[c];
+    for (int w = 0; w < TREND_WINDOW_COUNT; w++)
+    {
+      windowStats(&Windows[w], c, &stats.channel[c].window[w]);
+    }
+  }
+  stats.samples = SampleCount;
+  stats.activeRules = checkRules(&stats);
+
+  portENTER_CRITICAL(&StatsLock);
+  Published = stats;
+  portEXIT_CRITICAL(&StatsLock);
+}
+
+// See header file for documentation block
+void trend_GetStats(TrendStats_t * stats)
+{
+  portENTER_CRITICAL(&StatsLock);
+  *stats = Published;
+  portEXIT_CRITICAL(&StatsLock);
+}
+
+// See header file for documentation block
+const char * trend_GetRuleName(uint8_t rule)
+{
+  return (rule < RULE_COUNT) ? Rules[rule].name : NULL;
+}
+
+// See header file for documentation block
+const char * trend_GetWindowName(TrendWindow_t window)
+{
+  return WindowNames[window];
+}
\ No newline at end of file
@@ -0,0 +1,394 @@
+/**
+  ******************************************************************************
+  * @file    tscodec.cpp
+  * @author  Brian Schmalz
+  * @brief   Gorilla style time series block codec
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "tscodec.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+/* Private define ------------------------------------------------------------*/
+
+// Time between samples, as the change from the previous gap (delta of delta):
+//   0                 : same gap as before
+//   10   + 7 bits     : -64 .. 63 ms
+//   110  + 9 bits     : -256 .. 255 ms
+//   1110 + 12 bits    : -2048 .. 2047 ms
+//   1111 + 64 bits    : full timestamp (first sample, clock changes)
+#define TIME_FULL_BITS    (4 + 64)
+
+// Values, as the change from the previous sample:
+//   0                 : unchanged
+//   10   + 7 bits     : -64 .. 63
+//   110  + 12 bits    : -2048 .. 2047
+//   111  + 32 bits    : full value (first sample, big jumps)
+#define VALUE_FULL_BITS   (3 + 32)
+
+// Largest a single sample can be
+#define SAMPLE_MAX_BITS   (TIME_FULL_BITS + 3 * VALUE_FULL_BITS)
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Check if a value fits in a signed field of n bits
+  * @param  value : value to check
+  * @param  n : field width
+  * @retval true if it fits
+  */
+static bool fitsSigned(int64_t value, uint8_t n)
+{
+  return value >= -((int64_t)1 << (n - 1)) && value < ((int64_t)1 << (n - 1));
+}
+
+/**
+  * @brief  Append bits to a stream, most significant first. The caller
+  *         has already checked there is room.
+  * @param  encoder : stream to append to
+  * @param  value : bits to append, in the low n bits
+  * @param  n : number of bits
+  * @retval none
+  */
+static void putBits(TsEncoder_t * encoder, uint64_t value, uint8_t n)
+{
+  while (n-- > 0)
+  {
+    if ((value >> n) & 1)
+    {
+      encoder->data[encoder->bits >> 3] |= 0x80 >> (encoder->bits & 7);
+    }
+    encoder->bits++;
+  }
+}
+
+/**
+  * @brief  Read bits from a stream, most significant first
+  * @param  decoder : stream to read from
+  * @param  n : number of bits
+  * @param  value : set to the bits read
+  * @retval false if the stream ends first
+  */
+static bool getBits(TsDecoder_t * decoder, uint8_t n, uint64_t * value)
+{
+  if (decoder->pos + n > decoder->bits)
+  {
+    return false;
+  }
+
+  *value = 0;
+  while (n-- > 0)
+  {
+    *value = (*value << 1) | ((decoder->data[decoder->pos >> 3] >> (7 - (decoder->pos & 7))) & 1);
+    decoder->pos++;
+  }
+  return true;
+}
+
+/**
+  * @brief  Read a signed field
+  * @param  decoder : stream to read from
+  * @param  n : field width
+  * @param  value : set to the sign extended field
+  * @retval false if the stream ends first
+  */
+static bool getSigned(TsDecoder_t * decoder, uint8_t n, int64_t * value)
+{
+  uint64_t bits;
+
+  if (!getBits(decoder, n, &bits))
+  {
+    return false;
+  }
+  *value = (int64_t)(bits << (64 - n)) >> (64 - n);
+  return true;
+}
+
+/**
+  * @brief  Count the ones before the first zero of a prefix code
+  * @param  decoder : stream to read from
+  * @param  max : longest prefix (stops after this many ones)
+  * @param  ones : set to the number of ones
+  * @retval false if the stream ends first
+  */
+static bool getPrefix(TsDecoder_t * decoder, uint8_t max, uint8_t * ones)
+{
+  uint64_t bit;
+
+  *ones = 0;
+  while (*ones < max)
+  {
+    if (!getBits(decoder, 1, &bit))
+    {
+      return false;
+    }
+    if (bit == 0)
+    {
+      break;
+    }
+    (*ones)++;
+  }
+  return true;
+}
+
+/**
+  * @brief  Append a timestamp
+  * @param  encoder : stream to append to
+  * @param  timeMs : the timestamp
+  * @param  full : store the full timestamp (first sample)
+  * @retval none
+  */
+static void putTime(TsEncoder_t * encoder, int64_t timeMs, bool full)
+{
+  int64_t delta = timeMs - encoder->last.timeMs;
+  int64_t dod = delta - encoder->lastDeltaMs;
+
+  if (full)
+  {
+    putBits(encoder, 0xF, 4);
+    putBits(encoder, (uint64_t)timeMs, 64);
+  }
+  else if (dod == 0)
+  {
+    putBits(encoder, 0x0, 1);
+  }
+  else if (fitsSigned(dod, 7))
+  {
+    putBits(encoder, 0x2, 2);
+    putBits(encoder, (uint64_t)dod & 0x7F, 7);
+  }
+  else if (fitsSigned(dod, 9))
+  {
+    putBits(encoder, 0x6, 3);
+    putBits(encoder, (uint64_t)dod & 0x1FF, 9);
+  }
+  else if (fitsSigned(dod, 12))
+  {
+    putBits(encoder, 0xE, 4);
+    putBits(encoder, (uint64_t)dod & 0xFFF, 12);
+  }
+  else
+  {
+    putBits(encoder, 0xF, 4);
+    putBits(encoder, (uint64_t)timeMs, 64);
+  }
+  encoder->lastDeltaMs = full ? 0 : delta;
+}
+
+/**
+  * @brief  Append one channel value
+  * @param  encoder : stream to append to
+  * @param  value : the value
+  * @param  last : the value in the previous sample
+  * @param  full : store the full value (first sample)
+  * @retval none
+  */
+static void putValue(TsEncoder_t * encoder, int32_t value, int32_t last, bool full)
+{
+  int64_t delta = (int64_t)value - last;
+
+  if (!full && delta == 0)
+  {
+    putBits(encoder, 0x0, 1);
+  }
+  else if (!full && fitsSigned(delta, 7))
+  {
+    putBits(encoder, 0x2, 2);
+    putBits(encoder, (uint64_t)delta & 0x7F, 7);
+  }
+  else if (!full && fitsSigned(delta, 12))
+  {
+    putBits(encoder, 0x6, 3);
+    putBits(encoder, (uint64_t)delta & 0xFFF, 12);
+  }
+  else
+  {
+    putBits(encoder, 0x7, 3);
+    putBits(encoder, (uint32_t)value, 32);
+  }
+}
+
+/**
+  * @brief  Read a timestamp written by putTime()
+  * @param  decoder : stream to read from
+  * @param  timeMs : set to the timestamp
+  * @retval false if the stream is corrupt
+  */
+static bool getTime(TsDecoder_t * decoder, int64_t * timeMs)
+{
+  static const uint8_t Width[] = { 0, 7, 9, 12 };
+  uint8_t ones;
+  int64_t dod = 0;
+
+  if (!getPrefix(decoder, 4, &ones))
+  {
+    return false;
+  }
+  if (ones == 4)
+  {
+    uint64_t full;
+    if (!getBits(decoder, 64, &full))
+    {
+      return false;
+    }
+    *timeMs = (int64_t)full;
+    decoder->lastDeltaMs = decoder->first ? 0 : *timeMs - decoder->last.timeMs;
+    return true;
+  }
+  if (ones > 0 && !getSigned(decoder, Width[ones], &dod))
+  {
+    return false;
+  }
+  if (decoder->first)
+  {
+    return false;
+  }
+  decoder->lastDeltaMs += dod;
+  *timeMs = decoder->last.timeMs + decoder->lastDeltaMs;
+  return true;
+}
+
+/**
+  * @brief  Read one channel value written by putValue()
+  * @param  decoder : stream to read from
+  * @param  last : the value in the previous sample
+  * @param  value : set to the value
+  * @retval false if the stream is corrupt
+  */
+static bool getValue(TsDecoder_t * decoder, int32_t last, int32_t * value)
+{
+  static const uint8_t Width[] = { 0, 7, 12 };
+  uint8_t ones;
+  int64_t delta = 0;
+
+  if (!getPrefix(decoder, 3, &ones))
+  {
+    return false;
+  }
+  if (ones == 3)
+  {
+    uint64_t full;
+    if (!getBits(decoder, 32, &full))
+    {
+      return false;
+    }
+    *value = (int32_t)(uint32_t)full;
+    return true;
+  }
+  if (ones > 0 && !getSigned(decoder, Width[ones], &delta))
+  {
+    return false;
+  }
+  if (decoder->first)
+  {
+    return false;
+  }
+  *value = (int32_t)(last + delta);
+  return true;
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+void tscodec_BeginEncode(TsEncoder_t * encoder, uint8_t * data, uint32_t size)
+{
+  memset(data, 0, size);
+  encoder->data = data;
+  encoder->capacity = size * 8;
+  encoder->bits = 0;
+  encoder->count = 0;
+  encoder->lastDeltaMs = 0;
+  memset(&encoder->last, 0, sizeof(encoder->last));
+}
+
+// See header file for documentation block
+bool tscodec_Encode(TsEncoder_t * encoder, const TsSample_t * sample)
+{
+  bool full = (encoder->count == 0);
+
+  // Checking against the worst case keeps the encoder simple; it only
+  // costs the last few bytes of a block
+  if (encoder->bits + SAMPLE_MAX_BITS > encoder->capacity || encoder->count == UINT16_MAX)
+  {
+    return false;
+  }
+
+  putTime(encoder, sample->timeMs, full);
+  putValue(encoder, sample->temperature, encoder->last.temperature, full);
+  putValue(encoder, sample->humidity, encoder->last.humidity, full);
+  putValue(encoder, sample->pressure, encoder->last.pressure, full);
+  encoder->last = *sample;
+  encoder->count++;
+  return true;
+}
+
+// See header file for documentation block
+void tscodec_BeginDecode(TsDecoder_t * decoder, const uint8_t * data, uint32_t bits, uint16_t count)
+{
+  decoder->data = data;
+  decoder->bits = bits;
+  decoder->pos = 0;
+  decoder->remaining = count;
+  decoder->first = true;
+  decoder->lastDeltaMs = 0;
+  memset(&decoder->last, 0, sizeof(decoder->last));
+}
+
+// See header file for documentation block
+bool tscodec_Decode(TsDecoder_t * decoder, TsSample_t * sample)
+{
+  if (decoder->remaining == 0)
+  {
+    return false;
+  }
+
+  if (!getTime(decoder, &sample->timeMs) ||
+      !getValue(decoder, decoder->last.temperature, &sample->temperature) ||
+      !getValue(decoder, decoder->last.humidity, &sample->humidity) ||
+      !getValue(decoder, decoder->last.pressure, &sample->pressure))
+  {
+    decoder->remaining = 0;
+    return false;
+  }
+  decoder->first = false;
+  decoder->last = *sample;
+  decoder->remaining--;
+  return true;
+}
\ No newline at end of file
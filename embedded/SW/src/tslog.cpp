@@ -0,0 +1,578 @@
+/**
+  ******************************************************************************
+  * @file    tslog.cpp
+  * @author  Brian Schmalz
+  * @brief   Persistent compressed sample log on LittleFS
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <rom/crc.h>
+#include "tslog.h"
+#include "logger.h"
+#include "metrics.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+// Start of every block on flash, followed by the encoded samples
+typedef struct {
+  uint32_t magic;               // TSLOG_MAGIC
+  uint32_t crc;                 // CRC32 of the rest of the block after this field
+  int64_t firstMs;              // Time of the first sample
+  int64_t lastMs;               // Time of the last sample
+  uint16_t count;               // Samples in the block
+  uint16_t bits;                // Bits of encoded samples
+  uint32_t reserved;
+} TslogHeader_t;
+
+// What is known about one segment file, so reads can skip whole segments
+typedef struct {
+  uint32_t number;              // Segment files are /log/<number>.seg
+  uint16_t blocks;              // Complete, checked blocks in the file
+  int64_t firstMs;              // Time of the first sample
+  int64_t lastMs;               // Time of the last sample
+} TslogSegment_t;
+
+/* Private define ------------------------------------------------------------*/
+
+#define TSLOG_DIR               "/log"
+#define TSLOG_MAGIC             0x474C5354    // "TSLG"
+#define TSLOG_PAYLOAD_SIZE      (TSLOG_BLOCK_SIZE - sizeof(TslogHeader_t))
+
+// Samples older than 2020-01-01 were taken before the clock was set
+#define TSLOG_MIN_TIME_MS       1577836800000LL
+
+// After n write failures in a row, the next 2^n - 1 blocks are dropped
+// before trying again (at most 63, about 2 hours at 1 Hz)
+#define TSLOG_BACKOFF_MAX       6
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+/// NOTE: The segment index is shared between the sensor task (appending and
+/// rotating) and the AsyncTCP task (reading). It is only touched under
+/// SegmentLock, and file access happens outside the lock. A reader that
+/// loses a segment to rotation just moves on to the next one.
+static TslogSegment_t Segments[TSLOG_MAX_SEGMENTS];
+static uint8_t SegmentCount;
+static portMUX_TYPE SegmentLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Set once the file system is mounted
+static bool Mounted;
+
+// The newest segment may be appended to (false after a failed write or a
+// torn block found at boot, so the next block starts a fresh segment)
+static bool Appendable;
+
+// Write failures in a row, and blocks still to drop before the next try
+static uint8_t WriteFailures;
+static uint16_t BackoffBlocks;
+
+// Block being filled by the sensor task
+static uint8_t WriteBlock[TSLOG_BLOCK_SIZE];
+static TsEncoder_t Encoder;
+static int64_t WriteFirstMs;
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+static_assert(sizeof(TslogHeader_t) == 32, "block header layout changed");
+
+/**
+  * @brief  Build the path of a segment file
+  * @param  path : buffer of at least 24 bytes
+  * @param  number : segment number
+  * @retval none
+  */
+static void segmentPath(char * path, uint32_t number)
+{
+  snprintf(path, 24, TSLOG_DIR "/%08u.seg", (unsigned)number);
+}
+
+/**
+  * @brief  Check that a block is complete and undamaged
+  * @param  block : TSLOG_BLOCK_SIZE bytes read from flash
+  * @retval true if the block can be decoded
+  */
+static bool checkBlock(const uint8_t * block)
+{
+  const TslogHeader_t * header = (const TslogHeader_t *)block;
+
+  return header->magic == TSLOG_MAGIC &&
+         header->count > 0 &&
+         header->bits <= TSLOG_PAYLOAD_SIZE * 8 &&
+         header->crc == crc32_le(0, block + 8, TSLOG_BLOCK_SIZE - 8);
+}
+
+/**
+  * @brief  Read one block of an open segment file
+  * @param  file : the segment
+  * @param  index : block number within the segment
+  * @param  block : TSLOG_BLOCK_SIZE bytes to read into
+  * @retval true if a complete, undamaged block was read
+  */
+static bool readBlock(File & file, uint16_t index, uint8_t * block)
+{
+  return file.seek((uint32_t)index * TSLOG_BLOCK_SIZE) &&
+         file.read(block, TSLOG_BLOCK_SIZE) == TSLOG_BLOCK_SIZE &&
+         checkBlock(block);
+}
+
+/**
+  * @brief  Work out the blocks and time range of a segment found at boot.
+  *         A torn or damaged block at the end (power lost mid write) is left
+  *         out, and the segment is marked not to be appended to.
+  * @param  segment : number filled in, the rest is set here
+  * @param  clean : set false if the end of the file is not a good block
+  * @retval none
+  */
+static void scanSegment(TslogSegment_t * segment, bool * clean)
+{
+  char path[24];
+  const TslogHeader_t * header = (const TslogHeader_t *)WriteBlock;
+
+  segment->blocks = 0;
+  segmentPath(path, segment->number);
+  File file = LittleFS.open(path, FILE_READ);
+  if (!file)
+  {
+    *clean = false;
+    return;
+  }
+
+  uint32_t size = file.size();
+  int32_t last = size / TSLOG_BLOCK_SIZE;
+  *clean = (size % TSLOG_BLOCK_SIZE) == 0;
+
+  // Walk back to the newest good block
+  while (--last >= 0)
+  {
+    if (readBlock(file, last, WriteBlock))
+    {
+      segment->blocks = last + 1;
+      segment->lastMs = header->lastMs;
+      break;
+    }
+    *clean = false;
+  }
+  if (segment->blocks > 0 && readBlock(file, 0, WriteBlock))
+  {
+    segment->firstMs = header->firstMs;
+  }
+  else
+  {
+    segment->blocks = 0;
+  }
+  file.close();
+}
+
+/**
+  * @brief  Start a new segment, deleting the oldest if the log is at its cap.
+  *         Whole segments are written once and deleted once, never
+  *         rewritten, which spreads flash wear with LittleFS's own leveling.
+  *         An empty newest segment is reused instead.
+  * @retval none
+  */
+static void startSegment(void)
+{
+  char path[24];
+  uint32_t number = (SegmentCount > 0) ? Segments[SegmentCount - 1].number + 1 : 0;
+
+  // A newest segment with no good block in it (its first write failed) is
+  // started over rather than left to take a place under the cap, so
+  // failing writes can never rotate out the good history
+  if (SegmentCount > 0 && Segments[SegmentCount - 1].blocks == 0)
+  {
+    segmentPath(path, Segments[SegmentCount - 1].number);
+    LittleFS.remove(path);
+    Appendable = true;
+    return;
+  }
+
+  if (SegmentCount == TSLOG_MAX_SEGMENTS)
+  {
+    segmentPath(path, Segments[0].number);
+    portENTER_CRITICAL(&SegmentLock);
+    memmove(&Segments[0], &Segments[1], (SegmentCount - 1) * sizeof(Segments[0]));
+    SegmentCount--;
+    portEXIT_CRITICAL(&SegmentLock);
+    LittleFS.remove(path);
+  }
+
+  portENTER_CRITICAL(&SegmentLock);
+  Segments[SegmentCount].number = number;
+  Segments[SegmentCount].blocks = 0;
+  Segments[SegmentCount].firstMs = 0;
+  Segments[SegmentCount].lastMs = 0;
+  SegmentCount++;
+  portEXIT_CRITICAL(&SegmentLock);
+  Appendable = true;
+}
+
+/**
+  * @brief  Seal the block being filled and append it to the newest segment,
+  *         or drop it while backing off after failed writes
+  * @retval none
+  */
+static void writeBlock(void)
+{
+  MetricsScope timer(METRIC_LOG_WRITE);
+  TslogHeader_t * header = (TslogHeader_t *)WriteBlock;
+  char path[24];
+
+  // Still backing off after failed writes: the samples stay in the RAM
+  // history, only their copy on flash is lost
+  if (BackoffBlocks > 0)
+  {
+    BackoffBlocks--;
+    return;
+  }
+
+  header->magic = TSLOG_MAGIC;
+  header->firstMs = WriteFirstMs;
+  header->lastMs = Encoder.last.timeMs;
+  header->count = Encoder.count;
+  header->bits = Encoder.bits;
+  header->reserved = 0;
+  header->crc = crc32_le(0, WriteBlock + 8, TSLOG_BLOCK_SIZE - 8);
+
+  if (!Appendable || SegmentCount == 0 || Segments[SegmentCount - 1].blocks >= TSLOG_SEGMENT_BLOCKS)
+  {
+    startSegment();
+  }
+
+  TslogSegment_t * segment = &Segments[SegmentCount - 1];
+  segmentPath(path, segment->number);
+  File file = LittleFS.open(path, FILE_APPEND);
+  size_t written = file ? file.write(WriteBlock, TSLOG_BLOCK_SIZE) : 0;
+  if (file)
+  {
+    file.close();
+  }
+  if (written != TSLOG_BLOCK_SIZE)
+  {
+    // Anything partly written stays past the indexed blocks and is never read
+    if (WriteFailures < TSLOG_BACKOFF_MAX)
+    {
+      WriteFailures++;
+    }
+    BackoffBlocks = (1 << WriteFailures) - 1;
+    LOGGER_ERROR("Log write to %s failed, skipping %u blocks", path, (unsigned)BackoffBlocks);
+    Appendable = false;
+    return;
+  }
+  WriteFailures = 0;
+
+  portENTER_CRITICAL(&SegmentLock);
+  if (segment->blocks == 0)
+  {
+    segment->firstMs = header->firstMs;
+  }
+  segment->lastMs = header->lastMs;
+  segment->blocks++;
+  portEXIT_CRITICAL(&SegmentLock);
+}
+
+/**
+  * @brief  Find the first block of a segment that ends at or after fromMs.
+  *         Blocks are fixed size, so this is a binary search on headers.
+  * @param  cursor : cursor with the range to find
+  * @param  segment : segment to search
+  * @retval index of the block
+  */
+static uint16_t locateBlock(TslogCursor_t * cursor, const TslogSegment_t * segment)
+{
+  char path[24];
+  TslogHeader_t header;
+  uint16_t low = 0;
+  uint16_t high = segment->blocks;
+
+  if (segment->firstMs >= cursor->fromMs)
+  {
+    return 0;
+  }
+
+  segmentPath(path, segment->number);
+  File file = LittleFS.open(path, FILE_READ);
+  if (!file)
+  {
+    return segment->blocks;
+  }
+  while (low < high)
+  {
+    uint16_t mid = low + (high - low) / 2;
+    if (file.seek((uint32_t)mid * TSLOG_BLOCK_SIZE) &&
+        file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+        header.magic == TSLOG_MAGIC && header.lastMs < cursor->fromMs)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  file.close();
+  return low;
+}
+
+/**
+  * @brief  Load the next block in the cursor's range
+  * @param  cursor : cursor to load into
+  * @retval false if there are no more blocks in range
+  */
+static bool loadLogBlock(TslogCursor_t * cursor)
+{
+  const TslogHeader_t * header = (const TslogHeader_t *)cursor->data;
+
+  for (;;)
+  {
+    TslogSegment_t segment;
+    bool found = false;
+
+    portENTER_CRITICAL(&SegmentLock);
+    for (uint8_t i = 0; i < SegmentCount && !found; i++)
+    {
+      if (Segments[i].number >= cursor->segment && Segments[i].blocks > 0)
+      {
+        segment = Segments[i];
+        found = true;
+      }
+    }
+    portEXIT_CRITICAL(&SegmentLock);
+
+    if (!found || segment.firstMs > cursor->toMs)
+    {
+      return false;
+    }
+    if (segment.number != cursor->segment)
+    {
+      cursor->segment = segment.number;
+      cursor->block = 0;
+      cursor->located = false;
+    }
+    if (segment.lastMs < cursor->fromMs || cursor->block >= segment.blocks)
+    {
+      cursor->segment++;
+      cursor->block = 0;
+      cursor->located = false;
+      continue;
+    }
+    if (!cursor->located)
+    {
+      cursor->block = locateBlock(cursor, &segment);
+      cursor->located = true;
+      continue;
+    }
+
+    char path[24];
+    bool ok;
+    segmentPath(path, segment.number);
+    File file = LittleFS.open(path, FILE_READ);
+    ok = file && readBlock(file, cursor->block, cursor->data);
+    if (file)
+    {
+      file.close();
+    }
+    cursor->block++;
+    if (!ok)
+    {
+      continue;
+    }
+    if (header->firstMs > cursor->toMs)
+    {
+      return false;
+    }
+    tscodec_BeginDecode(&cursor->decoder, cursor->data + sizeof(TslogHeader_t), header->bits, header->count);
+    return true;
+  }
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+bool tslog_Init(void)
+{
+  uint32_t numbers[TSLOG_MAX_SEGMENTS];
+  uint8_t count = 0;
+  char path[24];
+  bool clean = false;
+
+  if (!LittleFS.begin(true))
+  {
+    LOGGER_ERROR("LittleFS mount failed, sample log disabled");
+    return false;
+  }
+  LittleFS.mkdir(TSLOG_DIR);
+
+  // Keep the newest TSLOG_MAX_SEGMENTS segment numbers, sorted
+  File dir = LittleFS.open(TSLOG_DIR);
+  for (File file = dir.openNextFile(); file; file = dir.openNextFile())
+  {
+    const char * name = strrchr(file.name(), '/');
+    name = name ? name + 1 : file.name();
+    file.close();
+
+    char * end;
+    uint32_t number = strtoul(name, &end, 10);
+    if (end == name || strcmp(end, ".seg") != 0)
+    {
+      continue;
+    }
+
+    uint8_t at = count;
+    while (at > 0 && numbers[at - 1] > number)
+    {
+      at--;
+    }
+    if (count == TSLOG_MAX_SEGMENTS)
+    {
+      if (at == 0)
+      {
+        segmentPath(path, number);
+        LittleFS.remove(path);
+        continue;
+      }
+      segmentPath(path, numbers[0]);
+      LittleFS.remove(path);
+      memmove(&numbers[0], &numbers[1], (at - 1) * sizeof(numbers[0]));
+      at--;
+    }
+    else
+    {
+      memmove(&numbers[at + 1], &numbers[at], (count - at) * sizeof(numbers[0]));
+      count++;
+    }
+    numbers[at] = number;
+  }
+  dir.close();
+
+  // Index them, dropping any without a single good block
+  SegmentCount = 0;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    Segments[SegmentCount].number = numbers[i];
+    scanSegment(&Segments[SegmentCount], &clean);
+    if (Segments[SegmentCount].blocks > 0)
+    {
+      SegmentCount++;
+    }
+    else
+    {
+      segmentPath(path, numbers[i]);
+      LittleFS.remove(path);
+    }
+  }
+
+  // Only append to the newest segment if it ended cleanly
+  Appendable = (SegmentCount > 0) && clean && (numbers[count - 1] == Segments[SegmentCount - 1].number);
+  tscodec_BeginEncode(&Encoder, WriteBlock + sizeof(TslogHeader_t), TSLOG_PAYLOAD_SIZE);
+  Mounted = true;
+  LOGGER_INFO("Sample log: %u segments, %u KB used", (unsigned)SegmentCount, (unsigned)(LittleFS.usedBytes() / 1024));
+  return true;
+}
+
+// See header file for documentation block
+void tslog_Add(const TsSample_t * sample)
+{
+  if (!Mounted || sample->timeMs < TSLOG_MIN_TIME_MS)
+  {
+    return;
+  }
+
+  if (!tscodec_Encode(&Encoder, sample))
+  {
+    writeBlock();
+    tscodec_BeginEncode(&Encoder, WriteBlock + sizeof(TslogHeader_t), TSLOG_PAYLOAD_SIZE);
+    tscodec_Encode(&Encoder, sample);
+  }
+  if (Encoder.count == 1)
+  {
+    WriteFirstMs = sample->timeMs;
+  }
+}
+
+// See header file for documentation block
+void tslog_BeginRead(TslogCursor_t * cursor, int64_t fromMs, int64_t toMs)
+{
+  cursor->fromMs = fromMs;
+  cursor->toMs = toMs;
+  cursor->segment = 0;
+  cursor->block = 0;
+  cursor->located = false;
+  cursor->loaded = false;
+  cursor->done = !Mounted || (toMs < fromMs);
+}
+
+// See header file for documentation block
+bool tslog_Next(TslogCursor_t * cursor, TsSample_t * sample)
+{
+  while (!cursor->done)
+  {
+    if (cursor->loaded && tscodec_Decode(&cursor->decoder, sample))
+    {
+      if (sample->timeMs > cursor->toMs)
+      {
+        cursor->done = true;
+      }
+      else if (sample->timeMs >= cursor->fromMs)
+      {
+        return true;
+      }
+      continue;
+    }
+    cursor->loaded = loadLogBlock(cursor);
+    cursor->done = !cursor->loaded;
+  }
+  return false;
+}
+
+// See header file for documentation block
+bool tslog_GetOldest(int64_t * timeMs)
+{
+  bool found = false;
+
+  portENTER_CRITICAL(&SegmentLock);
+  for (uint8_t i = 0; i < SegmentCount && !found; i++)
+  {
+    if (Segments[i].blocks > 0)
+    {
+      *timeMs = Segments[i].firstMs;
+      found = true;
+    }
+  }
+  portEXIT_CRITICAL(&SegmentLock);
+  return found;
+}
\ No newline at end of file
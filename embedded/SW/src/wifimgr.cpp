@@ -0,0 +1,448 @@
+/**
+  ******************************************************************************
+  * @file    wifimgr.cpp
+  * @author  Brian Schmalz
+  * @brief   Background WiFi manager: fast reconnect and backoff
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <Arduino.h>
+#include <WiFi.h>
+#include <Preferences.h>
+#include <FreeRTOS.h>
+#include "wifimgr.h"
+#include "boot.h"
+#include "logger.h"
+#include "metrics.h"
+#include "topology.h"
+
+/* Private typedef -----------------------------------------------------------*/
+
+// Where we were last connected, kept in NVS. Addresses are in IPAddress
+// uint32_t form.
+typedef struct {
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns;
+} WifiCache_t;
+
+/* Private define ------------------------------------------------------------*/
+
+// How long to wait for an address when going straight to the cached access
+// point, and when scanning for it
+#ifndef WIFIMGR_FAST_TIMEOUT_MS
+#define WIFIMGR_FAST_TIMEOUT_MS       3000
+#endif
+#ifndef WIFIMGR_CONNECT_TIMEOUT_MS
+#define WIFIMGR_CONNECT_TIMEOUT_MS    15000
+#endif
+
+// Wait after the first failed attempt, doubling up to the maximum. The
+// actual wait is picked at random from the upper half of that, so pucks
+// that lost the same access point do not all come back at once.
+#ifndef WIFIMGR_BACKOFF_MIN_MS
+#define WIFIMGR_BACKOFF_MIN_MS        500
+#endif
+#ifndef WIFIMGR_BACKOFF_MAX_MS
+#define WIFIMGR_BACKOFF_MAX_MS        60000
+#endif
+
+// Static address, to skip DHCP. Set all of these as string build flags,
+// i.e. -DWIFIMGR_STATIC_IP=\"192.168.1.50\" -DWIFIMGR_GATEWAY=\"192.168.1.1\"
+#ifdef WIFIMGR_STATIC_IP
+#ifndef WIFIMGR_SUBNET
+#define WIFIMGR_SUBNET                "255.255.255.0"
+#endif
+#ifndef WIFIMGR_DNS
+#define WIFIMGR_DNS                   WIFIMGR_GATEWAY
+#endif
+#endif
+
+// 1 to skip DHCP by using the address of the last lease again. Only safe
+// when the router reserves that address for the puck.
+#ifndef WIFIMGR_REUSE_LEASE
+#define WIFIMGR_REUSE_LEASE           0
+#endif
+
+// Task notification bits sent by the WiFi event handler
+#define WIFIMGR_EVENT_CONNECTED       0x01
+#define WIFIMGR_EVENT_GOT_IP          0x02
+#define WIFIMGR_EVENT_DISCONNECTED    0x04
+
+// Time for the driver to report the end of an attempt we stopped
+#define WIFIMGR_SETTLE_MS             100
+
+/* Private macro -------------------------------------------------------------*/
+
+/* Private variables ---------------------------------------------------------*/
+
+static const char * WifiSsid;
+static const char * WifiPassword;
+static void (*WifiOnConnected)(void);
+
+// Manager task, notified by the event handler
+static TaskHandle_t WifiTask = NULL;
+
+// Where we were last connected. Only the manager task uses these.
+static WifiCache_t WifiCache;
+static bool WifiCacheValid = false;
+
+// Connection history, copied out under WifiLock
+static WifiStats_t WifiStats;
+static portMUX_TYPE WifiLock = portMUX_INITIALIZER_UNLOCKED;
+
+/* Public variables ----------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Called by the Arduino event task on WiFi events. Passes them on
+  *         to the manager task.
+  * @param  event : the WiFi event
+  * @param  info : details of the event
+  * @retval none
+  */
+static void onWifiEvent(WiFiEvent_t event, WiFiEventInfo_t info)
+{
+  uint32_t bits;
+
+  switch (event)
+  {
+    case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+      boot_Mark(BOOT_STAGE_WIFI_CONNECTED);
+      bits = WIFIMGR_EVENT_CONNECTED;
+      break;
+
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+      bits = WIFIMGR_EVENT_GOT_IP;
+      break;
+
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+      portENTER_CRITICAL(&WifiLock);
+      WifiStats.lastReason = info.wifi_sta_disconnected.reason;
+      portEXIT_CRITICAL(&WifiLock);
+      bits = WIFIMGR_EVENT_DISCONNECTED;
+      break;
+
+    default:
+      return;
+  }
+
+  if (WifiTask != NULL)
+  {
+    xTaskNotify(WifiTask, bits, eSetBits);
+  }
+}
+
+/**
+  * @brief  Read where we were last connected from NVS. Ignored if it was
+  *         for a different access point.
+  * @param  none
+  * @retval none
+  */
+static void loadCache(void)
+{
+  Preferences prefs;
+
+  if (!prefs.begin("wifimgr", true))
+  {
+    return;
+  }
+  WifiCacheValid = prefs.getString("ssid", "") == WifiSsid &&
+                   prefs.getBytes("cache", &WifiCache, sizeof(WifiCache)) == sizeof(WifiCache) &&
+                   WifiCache.channel != 0;
+  prefs.end();
+}
+
+/**
+  * @brief  Remember where we are connected now, in RAM and NVS. NVS is only
+  *         written when something changed, to spare the flash.
+  * @param  none
+  * @retval none
+  */
+static void saveCache(void)
+{
+  WifiCache_t now;
+
+  memset(&now, 0, sizeof(now));
+  memcpy(now.bssid, WiFi.BSSID(), sizeof(now.bssid));
+  now.channel = WiFi.channel();
+  now.ip = WiFi.localIP();
+  now.gateway = WiFi.gatewayIP();
+  now.subnet = WiFi.subnetMask();
+  now.dns = WiFi.dnsIP();
+
+  if (WifiCacheValid && memcmp(&now, &WifiCache, sizeof(now)) == 0)
+  {
+    return;
+  }
+  WifiCache = now;
+  WifiCacheValid = true;
+
+  Preferences prefs;
+  if (prefs.begin("wifimgr", false))
+  {
+    prefs.putString("ssid", WifiSsid);
+    prefs.putBytes("cache", &WifiCache, sizeof(WifiCache));
+    prefs.end();
+  }
+}
+
+/**
+  * @brief  Pick how the next attempt gets its address: the static address
+  *         if one is built in, the last lease if it may be reused, or DHCP
+  * @param  none
+  * @retval none
+  */
+static void configureAddress(void)
+{
+#ifdef WIFIMGR_STATIC_IP
+  IPAddress ip, gateway, subnet, dns;
+  ip.fromString(WIFIMGR_STATIC_IP);
+  gateway.fromString(WIFIMGR_GATEWAY);
+  subnet.fromString(WIFIMGR_SUBNET);
+  dns.fromString(WIFIMGR_DNS);
+  WiFi.config(ip, gateway, subnet, dns);
+#else
+  if (WIFIMGR_REUSE_LEASE && WifiCacheValid && WifiCache.ip != 0)
+  {
+    WiFi.config(IPAddress(WifiCache.ip), IPAddress(WifiCache.gateway), IPAddress(WifiCache.subnet),
+                IPAddress(WifiCache.dns));
+  }
+  else
+  {
+    WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+  }
+#endif
+}
+
+/**
+  * @brief  Wait for events from the WiFi event handler
+  * @param  timeoutMs : longest time to wait, or 0 to wait forever
+  * @retval WIFIMGR_EVENT_* bits of the events that came in
+  */
+static uint32_t waitEvents(uint32_t timeoutMs)
+{
+  uint32_t events = 0;
+  xTaskNotifyWait(0, UINT32_MAX, &events, timeoutMs ? pdMS_TO_TICKS(timeoutMs) : portMAX_DELAY);
+  return events;
+}
+
+/**
+  * @brief  Stop the current attempt or connection, and throw away the
+  *         events it leaves behind
+  * @param  none
+  * @retval none
+  */
+static void stopConnection(void)
+{
+  WiFi.disconnect();
+  vTaskDelay(pdMS_TO_TICKS(WIFIMGR_SETTLE_MS));
+  waitEvents(1);
+}
+
+/**
+  * @brief  Make one attempt to connect and get an address
+  * @param  fast : true to go straight to the cached access point and
+  *         channel instead of scanning for it
+  * @retval true if we have an address
+  */
+static bool connectOnce(bool fast)
+{
+  uint32_t timeoutMs = fast ? WIFIMGR_FAST_TIMEOUT_MS : WIFIMGR_CONNECT_TIMEOUT_MS;
+  int64_t deadlineUs = esp_timer_get_time() + (int64_t)timeoutMs * 1000;
+
+  portENTER_CRITICAL(&WifiLock);
+  WifiStats.attempts++;
+  portEXIT_CRITICAL(&WifiLock);
+
+  configureAddress();
+  if (fast)
+  {
+    WiFi.begin(WifiSsid, WifiPassword, WifiCache.channel, WifiCache.bssid, true);
+  }
+  else
+  {
+    WiFi.begin(WifiSsid, WifiPassword);
+  }
+
+  for (;;)
+  {
+    int64_t remainingUs = deadlineUs - esp_timer_get_time();
+    if (remainingUs <= 0)
+    {
+      return false;
+    }
+    uint32_t events = waitEvents((uint32_t)(remainingUs / 1000) + 1);
+    if (events & WIFIMGR_EVENT_GOT_IP)
+    {
+      // A drop in the same batch wins if it came last
+      return WiFi.isConnected();
+    }
+    if (events & WIFIMGR_EVENT_DISCONNECTED)
+    {
+      return false;
+    }
+  }
+}
+
+/**
+  * @brief  How long to wait before the next attempt
+  * @param  failures : attempts failed in a row so far (1 or more)
+  * @retval wait in milliseconds
+  */
+static uint32_t backoffMs(uint32_t failures)
+{
+  uint32_t limit = WIFIMGR_BACKOFF_MIN_MS;
+  for (uint32_t i = 1; i < failures && limit < WIFIMGR_BACKOFF_MAX_MS; i++)
+  {
+    limit *= 2;
+  }
+  limit = min(limit, (uint32_t)WIFIMGR_BACKOFF_MAX_MS);
+  return limit / 2 + esp_random() % (limit / 2 + 1);
+}
+
+/**
+  * @brief  WiFi manager task. Connects, waits for the connection to drop
+  *         and connects again, backing off while the access point is away.
+  * @param  parameter : ignored
+  * @retval none
+  */
+static void runWifiManager(void * parameter)
+{
+  uint32_t failures = 0;
+  int64_t downSinceUs = 0;      // When the connection was lost, 0 at boot
+
+  for (;;)
+  {
+    bool fast = WifiCacheValid;
+    bool up = connectOnce(fast);
+    if (!up && fast)
+    {
+      LOGGER_INFO("Cached access point not answering, scanning");
+      stopConnection();
+      fast = false;
+      up = connectOnce(false);
+    }
+    if (!up)
+    {
+      stopConnection();
+      failures++;
+      uint32_t waitMs = backoffMs(failures);
+      LOGGER_WARN("WiFi connect to %s failed %u times, retrying in %u ms", WifiSsid, (unsigned)failures,
+                  (unsigned)waitMs);
+      vTaskDelay(pdMS_TO_TICKS(waitMs));
+      continue;
+    }
+
+    failures = 0;
+    saveCache();
+    boot_Mark(BOOT_STAGE_GOT_IP);
+
+    uint32_t downMs = downSinceUs ? (uint32_t)((esp_timer_get_time() - downSinceUs) / 1000) : 0;
+    portENTER_CRITICAL(&WifiLock);
+    WifiStats.connected = true;
+    if (fast)
+    {
+      WifiStats.fastConnects++;
+    }
+    if (downSinceUs)
+    {
+      WifiStats.reconnects++;
+      WifiStats.lastReconnectMs = downMs;
+      WifiStats.maxReconnectMs = max(WifiStats.maxReconnectMs, downMs);
+      WifiStats.totalReconnectMs += downMs;
+    }
+    portEXIT_CRITICAL(&WifiLock);
+
+    if (downSinceUs)
+    {
+      metrics_Increment(METRIC_WIFI_RECONNECTS);
+      LOGGER_INFO("WiFi back after %u ms. IP: %s", (unsigned)downMs, WiFi.localIP().toString().c_str());
+    }
+    else
+    {
+      LOGGER_INFO("Connected%s. IP: %s", fast ? " to cached access point" : "",
+                  WiFi.localIP().toString().c_str());
+    }
+    WifiOnConnected();
+
+    // Sleep until the connection drops
+    while (!(waitEvents(0) & WIFIMGR_EVENT_DISCONNECTED))
+    {
+    }
+    downSinceUs = esp_timer_get_time();
+
+    portENTER_CRITICAL(&WifiLock);
+    WifiStats.connected = false;
+    WifiStats.disconnects++;
+    uint8_t reason = WifiStats.lastReason;
+    portEXIT_CRITICAL(&WifiLock);
+
+    metrics_Increment(METRIC_WIFI_DISCONNECTS);
+    LOGGER_WARN("WiFi lost (reason %u), reconnecting", (unsigned)reason);
+    stopConnection();
+  }
+}
+
+/* Public functions ---------------------------------------------------------*/
+
+// See header file for documentation block
+void wifimgr_Init(const char * ssid, const char * password, void (*onConnected)(void))
+{
+  WifiSsid = ssid;
+  WifiPassword = password;
+  WifiOnConnected = onConnected;
+  loadCache();
+
+  // This module does the reconnecting and keeps its own record of the
+  // access point, so the driver should not retry or write to flash
+  WiFi.persistent(false);
+  WiFi.setAutoReconnect(false);
+  WiFi.mode(WIFI_STA);
+  WiFi.onEvent(onWifiEvent);
+
+  LOGGER_INFO("Connecting to %s", ssid);
+  topology_Create(TASK_WIFI, runWifiManager, NULL, &WifiTask);
+  boot_Mark(BOOT_STAGE_WIFI_START);
+}
+
+// See header file for documentation block
+void wifimgr_GetStats(WifiStats_t * stats)
+{
+  portENTER_CRITICAL(&WifiLock);
+  *stats = WifiStats;
+  portEXIT_CRITICAL(&WifiLock);
+}
\ No newline at end of file
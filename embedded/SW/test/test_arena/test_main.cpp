@@ -0,0 +1,375 @@
+/**
+  ******************************************************************************
+  * @file    test_arena/test_main.cpp
+  * @author  Brian Schmalz
+  * @brief   Host test that POST bodies are collected and parsed with no
+  *          heap allocation
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <new>
+#include <unity.h>
+#include "arena.h"
+
+/* Private define ------------------------------------------------------------*/
+
+// Parses of each body in the allocation test
+#define PARSE_ROUNDS      1000
+
+// Arenas per route, as HANDLERS_ARENAS
+#define POOL_ARENAS       2
+
+// On glibc, malloc() itself is replaced, which also catches ArduinoJson's
+// default allocator. Elsewhere only operator new is counted.
+#if defined(__GLIBC__)
+#define HOOK_MALLOC       1
+#else
+#define HOOK_MALLOC       0
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+
+// A POST body the Puck is sent, as in test_data/benchPuck.js
+typedef struct {
+  const char * body;
+  const char * key;         // Field whose value must point into the body
+} Body_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+// Allocations made while Counting is set
+static volatile bool Counting = false;
+static volatile unsigned Allocations = 0;
+
+static LedArena_t LedArenas[POOL_ARENAS];
+static LcdArena_t LcdArenas[POOL_ARENAS];
+static IconArena_t IconArenas[POOL_ARENAS];
+static StateArena_t StateArenas[POOL_ARENAS];
+
+static const Body_t LedBody = { "{\"red\":0,\"green\":0,\"blue\":40,\"blink\":0,\"onTime\":0,\"offTime\":0}", NULL };
+static const Body_t LcdBody = { "{\"text1\":\"Bench\",\"text2\":\"line 2\",\"text3\":\"line 3\",\"text4\":\"line 4\"}", "text1" };
+static const Body_t IconBody = { "{\"icon\":\"a02d\",\"x\":1,\"y\":60}", "icon" };
+static const Body_t StateBody = {
+  "{\"lcd\":{\"text1\":\"Bench\",\"text2\":\"line 2\",\"text3\":\"line 3\",\"text4\":\"line 4\"},"
+  "\"led\":{\"red\":40,\"green\":0,\"blue\":0,\"blink\":1,\"onTime\":500,\"offTime\":500}}", NULL };
+
+/* Allocation hooks ----------------------------------------------------------*/
+
+#if HOOK_MALLOC
+extern "C" void * __libc_malloc(size_t size);
+extern "C" void * __libc_calloc(size_t count, size_t size);
+extern "C" void * __libc_realloc(void * ptr, size_t size);
+
+extern "C" void * malloc(size_t size)
+{
+  if (Counting)
+  {
+    Allocations = Allocations + 1;
+  }
+  return __libc_malloc(size);
+}
+
+extern "C" void * calloc(size_t count, size_t size)
+{
+  if (Counting)
+  {
+    Allocations = Allocations + 1;
+  }
+  return __libc_calloc(count, size);
+}
+
+extern "C" void * realloc(void * ptr, size_t size)
+{
+  if (Counting)
+  {
+    Allocations = Allocations + 1;
+  }
+  return __libc_realloc(ptr, size);
+}
+#endif
+
+void * operator new(size_t size)
+{
+  if (Counting && !HOOK_MALLOC)
+  {
+    Allocations = Allocations + 1;
+  }
+  void * ptr = malloc(size ? size : 1);
+  if (ptr == NULL)
+  {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void * operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void * operator new(size_t size, const std::nothrow_t &) noexcept
+{
+  if (Counting && !HOOK_MALLOC)
+  {
+    Allocations = Allocations + 1;
+  }
+  return malloc(size ? size : 1);
+}
+
+void * operator new[](size_t size, const std::nothrow_t & tag) noexcept
+{
+  return operator new(size, tag);
+}
+
+void operator delete(void * ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete(void * ptr, size_t) noexcept
+{
+  free(ptr);
+}
+
+void operator delete[](void * ptr, size_t) noexcept
+{
+  free(ptr);
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Collect a body into an arena of a pool in chunks, the way
+  *         collectBody() is fed by the server, and parse it
+  * @param  pool : the route's arenas
+  * @param  body : the body to send
+  * @param  chunk : most bytes per chunk
+  * @param  arena : filled in with the arena taken
+  * @retval result of arena_Parse(), or InvalidInput if no arena was free
+  *         or the body did not fit
+  */
+template <typename Arena>
+DeserializationError collectAndParse(Arena * pool, const char * body, size_t chunk, ArenaHeader_t ** arena)
+{
+  size_t total = strlen(body);
+
+  *arena = arena_Take(pool, POOL_ARENAS);
+  if (*arena == NULL)
+  {
+    return DeserializationError::InvalidInput;
+  }
+  for (size_t index = 0; index < total; index += chunk)
+  {
+    size_t len = (total - index < chunk) ? total - index : chunk;
+    arena_Append(*arena, (const uint8_t *)body + index, len, index, total);
+  }
+  if ((*arena)->overflow || (*arena)->length != total)
+  {
+    return DeserializationError::InvalidInput;
+  }
+  return arena_Parse(*arena);
+}
+
+/**
+  * @brief  Collect and parse a body many times in chunks of several sizes,
+  *         counting heap allocations
+  * @param  pool : the route's arenas
+  * @param  body : the body to send, and a string field to check
+  * @param  name : route name for the report
+  * @retval none
+  */
+template <typename Arena>
+void checkNoAllocations(Arena * pool, const Body_t * body, const char * name)
+{
+  static const size_t Chunks[] = { 1, 7, 64, 4096 };
+  unsigned parses = 0;
+  unsigned failures = 0;
+
+  Allocations = 0;
+  for (int round = 0; round < PARSE_ROUNDS; round++)
+  {
+    for (size_t c = 0; c < sizeof(Chunks) / sizeof(Chunks[0]); c++)
+    {
+      ArenaHeader_t * arena;
+
+      Counting = true;
+      DeserializationError error = collectAndParse(pool, body->body, Chunks[c], &arena);
+      Counting = false;
+
+      if (error)
+      {
+        failures++;
+      }
+      else if (body->key != NULL)
+      {
+        // Strings are left in the body rather than copied out of it
+        const char * value = (*arena->doc)[body->key];
+        if (value < arena->body || value >= arena->body + arena->size)
+        {
+          failures++;
+        }
+      }
+      if (arena != NULL)
+      {
+        arena_Release(arena);
+      }
+      parses++;
+    }
+  }
+
+  char line[96];
+  snprintf(line, sizeof(line), "%s: %u parses, %u allocations", name, parses, (unsigned)Allocations);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_EQUAL_UINT32(0, failures);
+  TEST_ASSERT_EQUAL_UINT32(0, Allocations);
+}
+
+void setUp(void)
+{
+  Counting = false;
+}
+
+void tearDown(void)
+{
+  Counting = false;
+}
+
+/* Tests ---------------------------------------------------------------------*/
+
+void test_hooks_count_allocations(void)
+{
+  // Without this, a hook that never fires would pass every other test
+  Allocations = 0;
+  Counting = true;
+  int * volatile number = new int(1);
+  void * volatile block = malloc(16);
+  Counting = false;
+
+  delete number;
+  free(block);
+  TEST_ASSERT_EQUAL_UINT32(HOOK_MALLOC ? 2 : 1, Allocations);
+}
+
+void test_parse_allocates_nothing(void)
+{
+  checkNoAllocations(LedArenas, &LedBody, "/led");
+  checkNoAllocations(LcdArenas, &LcdBody, "/lcd");
+  checkNoAllocations(IconArenas, &IconBody, "/icon");
+  checkNoAllocations(StateArenas, &StateBody, "/state");
+}
+
+void test_chunks_are_reassembled(void)
+{
+  ArenaHeader_t * arena;
+
+  TEST_ASSERT_FALSE(collectAndParse(StateArenas, StateBody.body, 3, &arena));
+  TEST_ASSERT_EQUAL_STRING("line 4", (*arena->doc)["lcd"]["text4"].as<const char *>());
+  TEST_ASSERT_EQUAL_INT(500, (*arena->doc)["led"]["offTime"].as<int>());
+  arena_Release(arena);
+}
+
+void test_body_too_big_overflows(void)
+{
+  char body[sizeof(IconArenas[0].body) + 1];
+  ArenaHeader_t * arena;
+
+  memset(body, ' ', sizeof(body) - 1);
+  body[sizeof(body) - 1] = '\0';
+  collectAndParse(IconArenas, body, 16, &arena);
+  TEST_ASSERT_NOT_NULL(arena);
+  TEST_ASSERT_TRUE(arena->overflow);
+  TEST_ASSERT_EQUAL_UINT32(0, arena->length);
+  arena_Release(arena);
+}
+
+void test_too_many_fields_runs_out_of_memory(void)
+{
+  ArenaHeader_t * arena;
+  char body[128] = "{";
+
+  // The icon document has room for 8 fields
+  for (int i = 0; i < 9; i++)
+  {
+    char field[16];
+    snprintf(field, sizeof(field), "%s\"f%d\":%d", i ? "," : "", i, i);
+    strcat(body, field);
+  }
+  strcat(body, "}");
+
+  Allocations = 0;
+  Counting = true;
+  DeserializationError error = collectAndParse(IconArenas, body, sizeof(body), &arena);
+  Counting = false;
+
+  TEST_ASSERT_TRUE(error == DeserializationError::NoMemory);
+  TEST_ASSERT_EQUAL_UINT32(0, Allocations);
+  arena_Release(arena);
+}
+
+void test_pool_runs_out(void)
+{
+  ArenaHeader_t * taken[POOL_ARENAS];
+
+  for (int i = 0; i < POOL_ARENAS; i++)
+  {
+    taken[i] = arena_Take(LcdArenas, POOL_ARENAS);
+    TEST_ASSERT_NOT_NULL(taken[i]);
+  }
+  TEST_ASSERT_NULL(arena_Take(LcdArenas, POOL_ARENAS));
+
+  arena_Release(taken[0]);
+  TEST_ASSERT_EQUAL_PTR(taken[0], arena_Take(LcdArenas, POOL_ARENAS));
+  for (int i = 0; i < POOL_ARENAS; i++)
+  {
+    arena_Release(taken[i]);
+  }
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_hooks_count_allocations);
+  RUN_TEST(test_parse_allocates_nothing);
+  RUN_TEST(test_chunks_are_reassembled);
+  RUN_TEST(test_body_too_big_overflows);
+  RUN_TEST(test_too_many_fields_runs_out_of_memory);
+  RUN_TEST(test_pool_runs_out);
+  return UNITY_END();
+}
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
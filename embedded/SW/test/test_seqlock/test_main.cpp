@@ -0,0 +1,259 @@
+/**
+  ******************************************************************************
+  * @file    test_seqlock/test_main.cpp
+  * @author  Brian Schmalz
+  * @brief   Host stress test for the sensor snapshot seqlock
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <unity.h>
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "sensor.h"
+#include "seqlock.h"
+
+/* Private define ------------------------------------------------------------*/
+
+// Samples the writer publishes at least, the reader threads racing it and
+// the consistent copies each reader must make before the writer stops
+#define STRESS_WRITES     2000000
+#define STRESS_READERS    3
+#define STRESS_READS      200000
+
+// Words in the wide value, big enough that a writer preempted part way
+// through is likely even with a single core
+#define WIDE_WORDS        64
+
+/* Private typedef -----------------------------------------------------------*/
+
+// Every word holds the same sample number
+typedef struct {
+  uint32_t words[WIDE_WORDS];
+} WideValue_t;
+
+/* Private variables ---------------------------------------------------------*/
+
+// Shared with every thread of the stress test
+SeqLock<SensorSnapshot_t> Shared;
+std::atomic<bool> WriterDone(false);
+std::atomic<uint32_t> Reads[STRESS_READERS];
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Make the snapshot for sample n. Every field is exact in its type,
+  *         so a reader can tell a torn copy from a whole one.
+  * @param  n : sample number
+  * @retval The snapshot
+  */
+SensorSnapshot_t makeSample(uint32_t n)
+{
+  SensorSnapshot_t sample;
+  sample.temperature = (float)(n % 100000);
+  sample.humidity = (float)(n % 100000) + 0.5f;
+  sample.pressure = -(float)(n % 100000);
+  sample.timestampMs = n * 7;
+  sample.sequence = n;
+  return sample;
+}
+
+/**
+  * @brief  Read until the writer is done, checking every copy is one whole
+  *         sample and that samples never go backwards
+  * @param  reader : index of this reader in Reads
+  * @param  torn : set to the number of inconsistent copies
+  * @param  retries : set to the number of times a write got in the way
+  * @retval none
+  */
+void readLoop(int reader, uint32_t * torn, uint32_t * retries)
+{
+  uint32_t last = 0;
+
+  *torn = 0;
+  *retries = 0;
+  while (!WriterDone.load(std::memory_order_acquire))
+  {
+    SensorSnapshot_t got;
+    if (!Shared.tryRead(&got))
+    {
+      (*retries)++;
+      continue;
+    }
+    SensorSnapshot_t expected = makeSample(got.sequence);
+    if (memcmp(&got, &expected, sizeof(got)) != 0 || got.sequence < last)
+    {
+      (*torn)++;
+    }
+    last = got.sequence;
+    Reads[reader].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+/**
+  * @brief  Check whether every reader has made enough consistent copies
+  * @param  none
+  * @retval true once all have made STRESS_READS
+  */
+bool readersDone(void)
+{
+  for (int i = 0; i < STRESS_READERS; i++)
+  {
+    if (Reads[i].load(std::memory_order_relaxed) < STRESS_READS)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ---------------------------------------------------------------------*/
+
+void test_starts_zeroed(void)
+{
+  SeqLock<SensorSnapshot_t> lock;
+  SensorSnapshot_t got = makeSample(1);
+
+  TEST_ASSERT_TRUE(lock.tryRead(&got));
+  TEST_ASSERT_EQUAL_UINT32(0, got.sequence);
+  TEST_ASSERT_EQUAL_UINT32(0, got.timestampMs);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, got.temperature);
+}
+
+void test_reads_back_last_write(void)
+{
+  SeqLock<SensorSnapshot_t> lock;
+  SensorSnapshot_t got;
+
+  lock.write(makeSample(41));
+  lock.write(makeSample(42));
+  TEST_ASSERT_TRUE(lock.tryRead(&got));
+  SensorSnapshot_t expected = makeSample(42);
+  TEST_ASSERT_EQUAL_MEMORY(&expected, &got, sizeof(got));
+}
+
+void test_readers_never_see_torn_samples(void)
+{
+  std::vector<std::thread> readers;
+  uint32_t torn[STRESS_READERS];
+  uint32_t retries[STRESS_READERS];
+  uint32_t n;
+
+  WriterDone.store(false);
+  Shared.write(makeSample(0));
+  for (int i = 0; i < STRESS_READERS; i++)
+  {
+    Reads[i].store(0);
+    readers.emplace_back(readLoop, i, &torn[i], &retries[i]);
+  }
+
+  // Keep writing until every reader has raced the writer for a while
+  for (n = 1; n <= STRESS_WRITES || !readersDone(); n++)
+  {
+    Shared.write(makeSample(n));
+  }
+  WriterDone.store(true, std::memory_order_release);
+
+  for (int i = 0; i < STRESS_READERS; i++)
+  {
+    readers[i].join();
+    char line[64];
+    snprintf(line, sizeof(line), "reader %d: %u reads, %u retries", i, (unsigned)Reads[i].load(), (unsigned)retries[i]);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_EQUAL_UINT32(0, torn[i]);
+  }
+
+  SensorSnapshot_t got;
+  TEST_ASSERT_TRUE(Shared.tryRead(&got));
+  TEST_ASSERT_EQUAL_UINT32(n - 1, got.sequence);
+}
+
+void test_wide_values_never_tear(void)
+{
+  static SeqLock<WideValue_t> wide;
+  std::atomic<bool> done(false);
+  std::atomic<uint32_t> reads(0);
+  uint32_t torn = 0;
+  WideValue_t value;
+
+  std::thread reader([&]() {
+    while (!done.load(std::memory_order_acquire))
+    {
+      WideValue_t got;
+      if (!wide.tryRead(&got))
+      {
+        continue;
+      }
+      for (int i = 1; i < WIDE_WORDS; i++)
+      {
+        if (got.words[i] != got.words[0])
+        {
+          torn++;
+          break;
+        }
+      }
+      reads.fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  for (uint32_t n = 1; n <= STRESS_WRITES || reads.load(std::memory_order_relaxed) < STRESS_READS; n++)
+  {
+    for (int i = 0; i < WIDE_WORDS; i++)
+    {
+      value.words[i] = n;
+    }
+    wide.write(value);
+  }
+  done.store(true, std::memory_order_release);
+  reader.join();
+
+  TEST_ASSERT_EQUAL_UINT32(0, torn);
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_starts_zeroed);
+  RUN_TEST(test_reads_back_last_write);
+  RUN_TEST(test_readers_never_see_torn_samples);
+  RUN_TEST(test_wide_values_never_tear);
+  return UNITY_END();
+}
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
@@ -0,0 +1,352 @@
+/**
+  ******************************************************************************
+  * @file    test_tscodec/test_main.cpp
+  * @author  Brian Schmalz
+  * @brief   Host round trip tests and benchmark for the sample codec
+  * 
+  * See https://github.com/davidtcalabrese/ISWAM for full information
+  *
+  ******************************************************************************
+  * @attention
+  * 
+  * The MIT License (MIT)
+  * Copyright © 2021 Brian Schmalz, David Calabrese
+  * Permission is hereby granted, free of charge, to any person obtaining a 
+  * copy of this software and associated documentation files (the “Software”), 
+  * to deal in the Software without restriction, including without limitation 
+  * the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+  * and/or sell copies of the Software, and to permit persons to whom the 
+  * Software is furnished to do so, subject to the following conditions:
+  *
+  * The above copyright notice and this permission notice shall be included in 
+  * all copies or substantial portions of the Software.
+  *
+  * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+  * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER 
+  * DEALINGS IN THE SOFTWARE.
+  *
+  ******************************************************************************
+  */ 
+
+/* Includes ------------------------------------------------------------------*/
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tscodec.h"
+
+/* Private define ------------------------------------------------------------*/
+
+// Bits for a sample whose time and values are all unchanged
+#define STEADY_BITS       4
+
+// Samples in the benchmark series (most of a day at 1 Hz, as many as one
+// stream can count) and the stream buffer
+#define BENCH_SAMPLES     60000
+#define BENCH_BYTES       (BENCH_SAMPLES * 8)
+
+/* Private variables ---------------------------------------------------------*/
+
+uint8_t Stream[BENCH_BYTES];
+TsSample_t Series[BENCH_SAMPLES];
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Make a sample
+  * @retval The sample
+  */
+TsSample_t sample(int64_t timeMs, int32_t temperature, int32_t humidity, int32_t pressure)
+{
+  TsSample_t s;
+  memset(&s, 0, sizeof(s));
+  s.timeMs = timeMs;
+  s.temperature = temperature;
+  s.humidity = humidity;
+  s.pressure = pressure;
+  return s;
+}
+
+/**
+  * @brief  Check two samples are the same, field by field (TsSample_t has
+  *         padding, so memcmp would compare garbage)
+  * @param  expected : the sample that was encoded
+  * @param  got : the sample that was decoded
+  * @retval none
+  */
+void assertSame(const TsSample_t * expected, const TsSample_t * got)
+{
+  TEST_ASSERT_EQUAL_INT64(expected->timeMs, got->timeMs);
+  TEST_ASSERT_EQUAL_INT32(expected->temperature, got->temperature);
+  TEST_ASSERT_EQUAL_INT32(expected->humidity, got->humidity);
+  TEST_ASSERT_EQUAL_INT32(expected->pressure, got->pressure);
+}
+
+/**
+  * @brief  Encode samples, then decode them and check they come back exactly
+  * @param  samples : samples to encode
+  * @param  count : number of samples
+  * @param  bits : set to the size of each encoded sample in bits (optional)
+  * @retval none
+  */
+void roundTrip(const TsSample_t * samples, int count, uint32_t * bits)
+{
+  TsEncoder_t encoder;
+  TsDecoder_t decoder;
+  TsSample_t got;
+
+  tscodec_BeginEncode(&encoder, Stream, sizeof(Stream));
+  for (int i = 0; i < count; i++)
+  {
+    uint32_t before = encoder.bits;
+    TEST_ASSERT_TRUE(tscodec_Encode(&encoder, &samples[i]));
+    if (bits != NULL)
+    {
+      bits[i] = encoder.bits - before;
+    }
+  }
+
+  tscodec_BeginDecode(&decoder, Stream, encoder.bits, encoder.count);
+  for (int i = 0; i < count; i++)
+  {
+    TEST_ASSERT_TRUE(tscodec_Decode(&decoder, &got));
+    assertSame(&samples[i], &got);
+  }
+  TEST_ASSERT_FALSE(tscodec_Decode(&decoder, &got));
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* Tests ---------------------------------------------------------------------*/
+
+void test_first_sample_is_full(void)
+{
+  TsSample_t samples[] = {
+    sample(1760000000000LL, 2150, 4500, 1013250),
+    sample(1760000001000LL, 2150, 4500, 1013250),
+    sample(1760000002000LL, 2150, 4500, 1013250),
+  };
+  uint32_t bits[3];
+
+  roundTrip(samples, 3, bits);
+  TEST_ASSERT_EQUAL_UINT32(4 + 64 + 3 * (3 + 32), bits[0]);
+
+  // The second sample sets the gap, after that a steady clock is one bit
+  TEST_ASSERT_EQUAL_UINT32(4 + 12 + 3, bits[1]);
+  TEST_ASSERT_EQUAL_UINT32(STEADY_BITS, bits[2]);
+}
+
+void test_time_buckets(void)
+{
+  // Changes in the gap right at the edge of each field, then one past it
+  static const struct {
+    int64_t dod;
+    uint32_t bits;
+  } Cases[] = {
+    { 0, 1 },
+    { 63, 2 + 7 }, { -64, 2 + 7 },
+    { 64, 3 + 9 }, { -65, 3 + 9 }, { 255, 3 + 9 }, { -256, 3 + 9 },
+    { 256, 4 + 12 }, { -257, 4 + 12 }, { 2047, 4 + 12 }, { -2048, 4 + 12 },
+    { 2048, 4 + 64 }, { -2049, 4 + 64 },
+  };
+
+  for (size_t c = 0; c < sizeof(Cases) / sizeof(Cases[0]); c++)
+  {
+    // Two samples to settle on a 10 s gap, then one with the changed gap
+    // and one more back on the steady clock of that gap
+    int64_t t = 1760000000000LL;
+    TsSample_t samples[4] = {
+      sample(t, 2150, 4500, 1013250),
+      sample(t + 10000, 2150, 4500, 1013250),
+      sample(t + 20000 + Cases[c].dod, 2150, 4500, 1013250),
+      sample(t + 30000 + 2 * Cases[c].dod, 2150, 4500, 1013250),
+    };
+    uint32_t bits[4];
+
+    roundTrip(samples, 4, bits);
+    TEST_ASSERT_EQUAL_UINT32(Cases[c].bits + 3, bits[2]);
+    TEST_ASSERT_EQUAL_UINT32(STEADY_BITS, bits[3]);
+  }
+}
+
+void test_value_buckets(void)
+{
+  static const struct {
+    int32_t delta;
+    uint32_t bits;
+  } Cases[] = {
+    { 0, 1 },
+    { 63, 2 + 7 }, { -64, 2 + 7 },
+    { 64, 3 + 12 }, { -65, 3 + 12 }, { 2047, 3 + 12 }, { -2048, 3 + 12 },
+    { 2048, 3 + 32 }, { -2049, 3 + 32 },
+  };
+
+  for (size_t c = 0; c < sizeof(Cases) / sizeof(Cases[0]); c++)
+  {
+    int64_t t = 1760000000000LL;
+    int32_t d = Cases[c].delta;
+    TsSample_t samples[3] = {
+      sample(t, 2150, 4500, 1013250),
+      sample(t + 1000, 2150, 4500, 1013250),
+      sample(t + 2000, 2150 + d, 4500 + d, 1013250 + d),
+    };
+    uint32_t bits[3];
+
+    roundTrip(samples, 3, bits);
+    TEST_ASSERT_EQUAL_UINT32(1 + 3 * Cases[c].bits, bits[2]);
+  }
+}
+
+void test_full_fallback_extremes(void)
+{
+  // Clock set backwards and forwards, and values at the ends of their range
+  TsSample_t samples[] = {
+    sample(5000, 0, 0, 0),
+    sample(6000, INT32_MAX, INT32_MIN, INT32_MAX),
+    sample(1760000000000LL, INT32_MIN, INT32_MAX, INT32_MIN),
+    sample(1760000001000LL, -4000, 10000, 300000),
+    sample(1759999000000LL, -4001, 9999, 300001),
+    sample(1759999001000LL, -4001, 9999, 300001),
+    sample(-1, 1, 1, 1),
+  };
+  uint32_t bits[7];
+
+  roundTrip(samples, 7, bits);
+  TEST_ASSERT_EQUAL_UINT32(4 + 64 + 3 * (3 + 32), bits[2]);
+  TEST_ASSERT_EQUAL_UINT32(4 + 64 + 3 * (2 + 7), bits[4]);
+}
+
+void test_truncated_stream(void)
+{
+  TsSample_t samples[20];
+  TsEncoder_t encoder;
+  TsDecoder_t decoder;
+  TsSample_t got;
+
+  for (int i = 0; i < 20; i++)
+  {
+    samples[i] = sample(1760000000000LL + i * 1000 + (i % 3) * 7, 2150 + i, 4500 - 3 * i, 1013250 + 100 * i);
+  }
+  tscodec_BeginEncode(&encoder, Stream, sizeof(Stream));
+  for (int i = 0; i < 20; i++)
+  {
+    TEST_ASSERT_TRUE(tscodec_Encode(&encoder, &samples[i]));
+  }
+
+  // Every cut decodes a prefix of the samples exactly, then stops
+  for (uint32_t cut = 0; cut < encoder.bits; cut++)
+  {
+    int decoded = 0;
+    tscodec_BeginDecode(&decoder, Stream, cut, encoder.count);
+    while (tscodec_Decode(&decoder, &got))
+    {
+      assertSame(&samples[decoded], &got);
+      decoded++;
+    }
+    TEST_ASSERT_TRUE(decoded < 20);
+    TEST_ASSERT_FALSE(tscodec_Decode(&decoder, &got));
+  }
+
+  // A count bigger than what was written stops at the end of the bits
+  int decoded = 0;
+  tscodec_BeginDecode(&decoder, Stream, encoder.bits, encoder.count + 5);
+  while (tscodec_Decode(&decoder, &got))
+  {
+    decoded++;
+  }
+  TEST_ASSERT_EQUAL_INT(20, decoded);
+}
+
+void test_full_buffer_refuses(void)
+{
+  uint8_t small[64];
+  TsEncoder_t encoder;
+  TsSample_t s = sample(1760000000000LL, 2150, 4500, 1013250);
+  int written = 0;
+
+  tscodec_BeginEncode(&encoder, small, sizeof(small));
+  while (tscodec_Encode(&encoder, &s))
+  {
+    s.timeMs += 1000;
+    written++;
+  }
+  uint32_t bits = encoder.bits;
+  TEST_ASSERT_TRUE(written > 1);
+  TEST_ASSERT_FALSE(tscodec_Encode(&encoder, &s));
+  TEST_ASSERT_EQUAL_UINT32(bits, encoder.bits);
+  TEST_ASSERT_EQUAL_UINT32(written, encoder.count);
+}
+
+void test_bench_1hz(void)
+{
+  TsEncoder_t encoder;
+  TsDecoder_t decoder;
+  TsSample_t got;
+  int32_t temperature = 2150;
+  int32_t humidity = 4500;
+  int32_t pressure = 1013250;
+  char line[128];
+
+  // Slow drift plus a count or two of noise, with the odd late sample,
+  // like the BME280 in forced mode at 1 Hz
+  srand(19);
+  for (int i = 0; i < BENCH_SAMPLES; i++)
+  {
+    temperature += rand() % 3 - 1;
+    humidity += rand() % 5 - 2;
+    pressure += rand() % 41 - 20;
+    int64_t jitter = (rand() % 50 == 0) ? rand() % 20 : 0;
+    Series[i] = sample(1760000000000LL + (int64_t)i * 1000 + jitter, temperature, humidity, pressure);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  tscodec_BeginEncode(&encoder, Stream, sizeof(Stream));
+  for (int i = 0; i < BENCH_SAMPLES; i++)
+  {
+    TEST_ASSERT_TRUE(tscodec_Encode(&encoder, &Series[i]));
+  }
+  auto encoded = std::chrono::steady_clock::now();
+  tscodec_BeginDecode(&decoder, Stream, encoder.bits, encoder.count);
+  for (int i = 0; i < encoder.count; i++)
+  {
+    TEST_ASSERT_TRUE(tscodec_Decode(&decoder, &got));
+    assertSame(&Series[i], &got);
+  }
+  auto decoded = std::chrono::steady_clock::now();
+
+  double bytesPerSample = encoder.bits / 8.0 / encoder.count;
+  snprintf(line, sizeof(line), "%u samples: %.2f bytes/sample (%u in RAM), encode %.0f ns, decode %.0f ns per sample",
+    (unsigned)encoder.count, bytesPerSample, (unsigned)sizeof(TsSample_t),
+    std::chrono::duration<double, std::nano>(encoded - start).count() / encoder.count,
+    std::chrono::duration<double, std::nano>(decoded - encoded).count() / encoder.count);
+  TEST_MESSAGE(line);
+
+  // A steady clock and small deltas take well under a fifth of the raw size
+  TEST_ASSERT_TRUE(bytesPerSample < 4.0);
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_first_sample_is_full);
+  RUN_TEST(test_time_buckets);
+  RUN_TEST(test_value_buckets);
+  RUN_TEST(test_full_fallback_extremes);
+  RUN_TEST(test_truncated_stream);
+  RUN_TEST(test_full_buffer_refuses);
+  RUN_TEST(test_bench_1hz);
+  return UNITY_END();
+}
+
+/**************** (C) COPYRIGHT Brian Schmalz *****END OF FILE****/
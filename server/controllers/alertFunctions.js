@@ -1,6 +1,6 @@
 const axios = require('axios');
 const config = require('../config.js').config;
-const { postDataLCD, postDataLED } = require('./puckFunctions');
+const { postDataLED, postDataState } = require('./puckFunctions');
 
 /**
  * Checks if there is an alert for entered zip code and that the alert's severity 
@@ -27,8 +27,8 @@ const processAlert = async (zip, severityThreshold, color) => {
 };
 
 /**
- * Prepares and sends two different POST requests to Puck. 
- * One controls the LEDs and the other controls the LCD.
+ * Prepares and sends one POST request to Puck's /state endpoint
+ * that updates both the LEDs and the LCD together.
  * 
  * @param {Array} data - Contains fields of alert values. 
  * @param {string} color - Desired color of alert LEDs.
@@ -38,8 +38,7 @@ const sendAlertToPuck = (data, color) => {
   const [red, green, blue] = parseColor(color);
   const LEDPost = buildLEDPost(red, green, blue, data.severity);
   const LCDPost = buildLCDPost(data);
-  postDataLCD(LCDPost); // send data to Puck's LCD
-  postDataLED(LEDPost); // send data to Puck's LEDs
+  postDataState(`{ "lcd": ${LCDPost}, "led": ${LEDPost} }`); // send data to Puck's LCD and LEDs
   setTimeout(clearLEDs, secondsToDispayAlert * 1000); // clear LEDs 
 }
 
@@ -36,5 +36,25 @@ const postDataLED = async data => {
   axios.post('http://192.168.1.178/led', data, options);
 };
 
+/**
+ * A function for sending POST requests to the Puck via axios.
+ * The /state endpoint takes optional lcd, led and icon sections and
+ * applies them together, so one request updates the whole Puck.
+ *
+ * @param data - Data that will be body of POST request.
+ */
+const postDataState = async data => {
+  // Default options are marked with *
+  const options = {
+    headers: {
+      Accept: 'application/json, text/plain, */*',
+      'Content-Type': 'text/plain',
+      Connection: 'keep-alive',
+    },
+  };
+  axios.post('http://192.168.1.178/state', data, options);
+};
+
 exports.postDataLCD = postDataLCD;
 exports.postDataLED = postDataLED;
+exports.postDataState = postDataState;
@@ -0,0 +1,208 @@
+import http from 'http';
+
+/**
+ * Host side load generator for the Puck's webserver.
+ *
+ * Hammers each Puck endpoint with a number of concurrent keep-alive
+ * connections for a fixed time, then prints requests/sec and latency
+ * percentiles for each endpoint. Only 2xx/3xx responses count towards
+ * requests/sec and latency. 4xx responses (e.g. 429 when the Puck is
+ * pushing back) are counted as rejected, and 5xx and connection failures
+ * as errors.
+ *
+ * Before benchmarking, it checks that each sensor endpoint answers a
+ * request carrying its ETag in If-None-Match with a bodyless 304.
+ *
+ * Run `node benchPuck <puck ip> [seconds per endpoint] [connections]`
+ */
+
+const host = process.argv[2];
+const seconds = +(process.argv[3] || 10);
+const connections = +(process.argv[4] || 4);
+
+const endpoints = [
+  { method: 'GET', path: '/temperature' },
+  { method: 'GET', path: '/humidity' },
+  { method: 'GET', path: '/pressure' },
+  { method: 'GET', path: '/env' },
+  {
+    method: 'POST',
+    path: '/lcd',
+    body: '{"text1":"Bench","text2":"line 2","text3":"line 3","text4":"line 4"}',
+  },
+  {
+    method: 'POST',
+    path: '/led',
+    body: '{"red":0,"green":0,"blue":40,"blink":0,"onTime":0,"offTime":0}',
+  },
+  { method: 'POST', path: '/icon', body: '{"icon":"a02d","x":1,"y":60}' },
+  {
+    method: 'POST',
+    path: '/state',
+    body:
+      '{"lcd":{"text1":"Bench","text2":"line 2","text3":"line 3","text4":"line 4"},' +
+      '"led":{"red":40,"green":0,"blue":0,"blink":1,"onTime":500,"offTime":500}}',
+  },
+];
+
+/**
+ * Sends one request and resolves with its status and latency.
+ *
+ * @param {http.Agent} agent - Keep-alive agent to send the request on.
+ * @param {Object} endpoint - Method, path and optional body and headers
+ *   to send.
+ * @returns {Promise<Object>} - HTTP status, ETag, body length and time in
+ *   milliseconds from send to end of response.
+ */
+const timeRequest = (agent, endpoint) =>
+  new Promise((resolve, reject) => {
+    const start = process.hrtime.bigint();
+    const req = http.request(
+      {
+        host,
+        port: 80,
+        agent,
+        method: endpoint.method,
+        path: endpoint.path,
+        headers: {
+          ...(endpoint.body ? { 'Content-Type': 'text/plain' } : {}),
+          ...endpoint.headers,
+        },
+      },
+      res => {
+        let length = 0;
+        res.on('data', chunk => {
+          length += chunk.length;
+        });
+        res.on('end', () => {
+          resolve({
+            status: res.statusCode,
+            etag: res.headers.etag,
+            length,
+            ms: Number(process.hrtime.bigint() - start) / 1e6,
+          });
+        });
+      },
+    );
+    req.on('error', reject);
+    if (endpoint.body) {
+      req.write(endpoint.body);
+    }
+    req.end();
+  });
+
+/**
+ * Returns the value at percentile p of an already sorted array.
+ *
+ * @param {Array} sorted - Latencies sorted ascending.
+ * @param {number} p - Percentile from 0 to 100.
+ * @returns {number} - Latency at that percentile.
+ */
+const percentile = (sorted, p) => {
+  if (sorted.length === 0) {
+    return 0;
+  }
+  const idx = Math.min(sorted.length - 1, Math.ceil((p / 100) * sorted.length) - 1);
+  return sorted[Math.max(0, idx)];
+};
+
+/**
+ * Runs the given number of closed-loop clients against one endpoint.
+ *
+ * @param {Object} endpoint - Endpoint to benchmark.
+ * @returns {Object} - Latencies of successful requests, rejected (4xx) and
+ *   error (5xx or failed) counts and elapsed time.
+ */
+const benchEndpoint = async endpoint => {
+  const agent = new http.Agent({ keepAlive: true, maxSockets: connections });
+  const latencies = [];
+  let rejected = 0;
+  let errors = 0;
+  const deadline = Date.now() + seconds * 1000;
+  const started = process.hrtime.bigint();
+
+  const client = async () => {
+    while (Date.now() < deadline) {
+      try {
+        const { status, ms } = await timeRequest(agent, endpoint);
+        if (status >= 500) {
+          errors++;
+        } else if (status >= 400) {
+          rejected++;
+        } else {
+          latencies.push(ms);
+        }
+      } catch (err) {
+        errors++;
+      }
+    }
+  };
+
+  await Promise.all(Array.from({ length: connections }, client));
+  const elapsed = Number(process.hrtime.bigint() - started) / 1e9;
+  agent.destroy();
+
+  latencies.sort((a, b) => a - b);
+  return { latencies, rejected, errors, elapsed };
+};
+
+/**
+ * Checks that a GET endpoint answers 304 with no body when sent its own
+ * ETag back in If-None-Match.
+ *
+ * @param {Object} endpoint - GET endpoint to check.
+ * @returns {Promise<string>} - Description of the result.
+ */
+const checkConditional = async endpoint => {
+  const agent = new http.Agent({ keepAlive: true });
+  try {
+    const first = await timeRequest(agent, endpoint);
+    if (!first.etag) {
+      return `no ETag (HTTP ${first.status})`;
+    }
+    const second = await timeRequest(agent, {
+      ...endpoint,
+      headers: { 'If-None-Match': first.etag },
+    });
+    if (second.status === 304 && second.length === 0) {
+      return `304 for ${first.etag}`;
+    }
+    if (second.etag !== first.etag) {
+      return `new sample taken in between, run again`;
+    }
+    return `FAILED: HTTP ${second.status} with ${second.length} bytes for ${first.etag}`;
+  } catch (err) {
+    return `FAILED: ${err.message}`;
+  } finally {
+    agent.destroy();
+  }
+};
+
+const main = async () => {
+  if (!host) {
+    console.log('Usage: node benchPuck <puck ip> [seconds per endpoint] [connections]');
+    process.exit(1);
+  }
+
+  for (const endpoint of endpoints.filter(e => e.method === 'GET')) {
+    console.log(`If-None-Match ${endpoint.path}: ${await checkConditional(endpoint)}`);
+  }
+
+  console.log(`Benchmarking ${host}: ${seconds}s per endpoint, ${connections} connections`);
+  console.log('endpoint            req/s    p50 ms    p99 ms    max ms  rejected  errors');
+  for (const endpoint of endpoints) {
+    const { latencies, rejected, errors, elapsed } = await benchEndpoint(endpoint);
+    const line = [
+      `${endpoint.method} ${endpoint.path}`.padEnd(18),
+      (latencies.length / elapsed).toFixed(1).padStart(7),
+      percentile(latencies, 50).toFixed(1).padStart(9),
+      percentile(latencies, 99).toFixed(1).padStart(9),
+      percentile(latencies, 100).toFixed(1).padStart(9),
+      `${rejected}`.padStart(9),
+      `${errors}`.padStart(7),
+    ];
+    console.log(line.join(' '));
+  }
+};
+
+main();